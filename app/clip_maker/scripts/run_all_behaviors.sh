@@ -35,3 +35,7 @@ echo "beh expr 2 0" | yarp rpc /clipMaker/rpc
 echo "beh expr 2 1" | yarp rpc /clipMaker/rpc 
 
 echo "home" | yarp rpc /clipMaker/rpc 
+
+# Or, regenerate only the clips whose config values changed since the
+# last run (see manifest.txt in clip_path). Use ``batch force`` to redo all.
+#echo "batch" | yarp rpc /clipMaker/rpc
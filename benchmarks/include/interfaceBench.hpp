@@ -0,0 +1,83 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef INTERFACE_BENCH_HPP
+#define INTERFACE_BENCH_HPP
+
+#include <string>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/RpcClient.h>
+
+#include <embodiedSocialInterface.hpp>
+
+
+/* ================================================================================
+**  Gives the benchmarks access to the interface's private draw and parse paths.
+** ================================================================================ */
+class EmbodiedSocialInterfaceBench {
+
+    public:
+    /* ============================================================================
+    **  Set the appearance vars configure() would read from the config file.
+    ** ============================================================================ */
+    static void setup(EmbodiedSocialInterface& esi, int tower, int height, int width, int shift) {
+        esi._max_tower_height = tower;
+        esi._window_height    = height;
+        esi._window_width     = width;
+        esi._right_shift      = shift;
+        esi._move_count       = 0;
+        esi._waiting_count    = 0;
+        esi._game_complete    = false;
+        esi._local_model      = true;
+        esi._expect_pending   = false;
+        esi._board_code       = false;
+        esi._has_code         = false;
+        esi._layout.build(3, 33, width, shift);
+        select(esi, -1, -1);
+    }
+
+    static void select(EmbodiedSocialInterface& esi, int from, int to) {
+        esi.selected_from = from;
+        esi.selected_to   = to;
+    }
+
+    static void parseShowable(EmbodiedSocialInterface& esi, const std::string& str) {
+        esi.parseShowable(str);
+    }
+
+    static HanoiModel& model(EmbodiedSocialInterface& esi) {
+        return esi._model;
+    }
+
+    static void drawInterface(EmbodiedSocialInterface& esi) {
+        esi.drawInterface();
+    }
+
+    static std::string communicate(EmbodiedSocialInterface& esi, const std::string msg, yarp::os::Bottle& cmd, yarp::os::Bottle& rsp) {
+        return esi.communicate(msg, cmd, rsp);
+    }
+
+    static yarp::os::RpcClient& rpc(EmbodiedSocialInterface& esi) {
+        return esi._rpc;
+    }
+
+};
+
+
+/* ================================================================================
+**  Build a board as the game server shows it: a header row, the peg tops, one
+**  row per disk level and the base. Disks start stacked on the left peg.
+** ================================================================================ */
+std::string makeBoard(int disks);
+
+#endif /* INTERFACE_BENCH_HPP */
@@ -0,0 +1,41 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <cstdio>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <csvLogger.hpp>
+
+
+//-- tmpfs, so the numbers are the logger's and not the disk's.
+static const std::string LOG_FILE = "/dev/shm/csvLoggerBench.csv";
+
+
+static void BM_CsvLoggerLog(benchmark::State& state) {
+
+    CsvLogger logger;
+    if (!logger.openLogger(LOG_FILE)) {
+        state.SkipWithError("unable to open the log on /dev/shm");
+        return;
+    }
+
+    int move = 0;
+    for (auto _ : state) {
+        logger.log(12.3456789, "user01", "icub-gaze", "0 2", "0012210", "1380", "5", move++, 0, 2, 10.25, 10.75, 11.5, 0.085);
+    }
+
+    logger.closeLogger();
+    std::remove(LOG_FILE.c_str());
+}
+BENCHMARK(BM_CsvLoggerLog);
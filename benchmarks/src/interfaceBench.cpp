@@ -0,0 +1,196 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <cstdio>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/Port.h>
+#include <yarp/os/PortReader.h>
+
+#include <ncurses.h>
+
+#include <interfaceBench.hpp>
+
+
+std::string makeBoard(int disks) {
+
+    const int num_pegs = 3;
+    const int cell     = 2 * disks + 3;
+
+    //-- One peg cell, with a disk of the given size (0 for none).
+    auto peg = [cell](int size) {
+        std::string row(cell, ' ');
+        if (size == 0) {
+            row[cell/2] = '|';
+        } else {
+            for (int idx = cell/2 - size; idx <= cell/2 + size; ++idx) row[idx] = '=';
+        }
+        return row;
+    };
+
+    std::string board = "\n";
+    for (int p = 0; p < num_pegs; ++p) board += peg(0);
+    board += "\n";
+
+    for (int level = 1; level <= disks; ++level) {
+        board += peg(level);
+        for (int p = 1; p < num_pegs; ++p) board += peg(0);
+        board += "\n";
+    }
+
+    board += std::string(cell * num_pegs, '#') + "\n";
+    return board;
+}
+
+
+/* ================================================================================
+**  parseShowable on 3 to 12 disk boards, the same every tick or changing
+**  every tick.
+** ================================================================================ */
+static void BM_ParseShowable(benchmark::State& state) {
+
+    EmbodiedSocialInterface esi;
+    EmbodiedSocialInterfaceBench::setup(esi, 13, 13, 36, 7);
+
+    std::string board = makeBoard(state.range(0));
+    std::string moved = board;
+    moved[moved.size() - 2] = '=';
+
+    bool changing = state.range(1);
+    std::size_t tick = 0;
+    for (auto _ : state) {
+        EmbodiedSocialInterfaceBench::parseShowable(esi, (changing && (tick++ % 2) ? moved : board));
+    }
+    state.SetBytesProcessed(state.iterations() * board.size());
+}
+BENCHMARK(BM_ParseShowable)->ArgsProduct({ { 3, 6, 9, 12 }, { 0, 1 } });
+
+
+/* ================================================================================
+**  A board that changes every tick, drawn from its code by the local model
+**  instead of sent in full.
+** ================================================================================ */
+static void BM_BoardFromCode(benchmark::State& state) {
+
+    EmbodiedSocialInterface esi;
+    EmbodiedSocialInterfaceBench::setup(esi, 13, 13, 36, 7);
+    EmbodiedSocialInterfaceBench::parseShowable(esi, makeBoard(state.range(0)));
+
+    HanoiModel model = EmbodiedSocialInterfaceBench::model(esi);
+    std::uint64_t start, moved;
+    model.encode(start);
+    model.apply(0, 2);
+    model.encode(moved);
+
+    std::string board;
+    std::size_t tick = 0;
+    for (auto _ : state) {
+        model.decode((tick++ % 2) ? moved : start);
+        model.render(board);
+        EmbodiedSocialInterfaceBench::parseShowable(esi, board);
+    }
+}
+BENCHMARK(BM_BoardFromCode)->Arg(3)->Arg(6)->Arg(9)->Arg(12);
+
+
+/* ================================================================================
+**  drawInterface into an ncurses screen that writes to /dev/null.
+** ================================================================================ */
+static void BM_DrawInterface(benchmark::State& state) {
+
+    FILE* devnull = std::fopen("/dev/null", "w+");
+    SCREEN* screen = newterm("xterm", devnull, devnull);
+    if (screen == NULL) {
+        std::fclose(devnull);
+        state.SkipWithError("unable to create an off-screen terminal");
+        return;
+    }
+    set_term(screen);
+
+    EmbodiedSocialInterface esi;
+    EmbodiedSocialInterfaceBench::setup(esi, 13, 13, 36, 7);
+    EmbodiedSocialInterfaceBench::select(esi, 1, (state.range(1) ? 3 : -1));
+    EmbodiedSocialInterfaceBench::parseShowable(esi, makeBoard(state.range(0)));
+
+    for (auto _ : state) {
+        EmbodiedSocialInterfaceBench::drawInterface(esi);
+    }
+
+    endwin();
+    delscreen(screen);
+    std::fclose(devnull);
+}
+BENCHMARK(BM_DrawInterface)->ArgsProduct({ { 3, 12 }, { 0, 1 } });
+
+
+/* ================================================================================
+**  communicate over a local yarp connection to a server that answers every
+**  request with a board.
+** ================================================================================ */
+class BoardServer : public yarp::os::PortReader {
+
+    public:
+    std::string board;
+
+    bool read(yarp::os::ConnectionReader& connection) override {
+
+        yarp::os::Bottle cmd, rsp;
+        if (!cmd.read(connection)) return false;
+
+        rsp.addString(board);
+        yarp::os::ConnectionWriter* writer = connection.getWriter();
+        if (writer != NULL) rsp.write(*writer);
+
+        return true;
+    }
+};
+
+
+static void BM_Communicate(benchmark::State& state) {
+
+    //-- In-process ports, no name server needed.
+    yarp::os::Network::setLocalMode(true);
+    yarp::os::Network yarp;
+
+    BoardServer server;
+    server.board = makeBoard(state.range(0));
+
+    yarp::os::Port server_port;
+    server_port.setReader(server);
+    if (!server_port.open("/bench/server")) {
+        state.SkipWithError("unable to open /bench/server");
+        return;
+    }
+
+    EmbodiedSocialInterface esi;
+    yarp::os::RpcClient& rpc = EmbodiedSocialInterfaceBench::rpc(esi);
+    if (!rpc.open("/bench/client") || !yarp::os::Network::connect("/bench/client", "/bench/server")) {
+        server_port.close();
+        state.SkipWithError("unable to connect /bench/client");
+        return;
+    }
+
+    yarp::os::Bottle cmd, rsp;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(EmbodiedSocialInterfaceBench::communicate(esi, "show", cmd, rsp));
+    }
+
+    rpc.close();
+    server_port.close();
+}
+BENCHMARK(BM_Communicate)->Arg(3)->Arg(12)->UseRealTime();
@@ -0,0 +1,55 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <stateMachine.hpp>
+
+
+static StateMachine makeMachine() {
+    StateMachine machine(0);
+    for (const char* state : { "icub-none", "icub-gaze", "blob", "icub-expression", "blob-none", "icub-body", "icub-speech" }) {
+        machine.addState(state);
+    }
+    machine.setMinSteps(3);
+    machine.setMaxSteps(3);
+    machine.setCurrentHint("0 2");
+    return machine;
+}
+
+
+static void BM_StateMachineStep(benchmark::State& state) {
+    StateMachine machine = makeMachine();
+    for (auto _ : state) {
+        machine.step();
+    }
+}
+BENCHMARK(BM_StateMachineStep);
+
+
+static void BM_StateMachineGetStateHint(benchmark::State& state) {
+    StateMachine machine = makeMachine();
+    machine.step(); machine.step(); machine.step(); // past icub-none.
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(machine.getStateHint("in"));
+    }
+}
+BENCHMARK(BM_StateMachineGetStateHint);
+
+
+static void BM_StateMachineSetCurrentHint(benchmark::State& state) {
+    StateMachine machine = makeMachine();
+    for (auto _ : state) {
+        machine.setCurrentHint("1 2");
+    }
+}
+BENCHMARK(BM_StateMachineSetCurrentHint);
@@ -0,0 +1,123 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef CHOREOGRAPHER_HPP
+#define CHOREOGRAPHER_HPP
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <clock.hpp>
+
+
+/* ================================================================================
+**  The controllers that can be commanded in parallel. Each gets its own worker.
+** ================================================================================ */
+enum class Track { LeftArm, RightArm, Gaze, Face };
+
+
+/* ================================================================================
+**  Runs timestamped commands on one worker thread per track, so that motions
+**  of different controllers overlap and a behavior lasts only as long as its
+**  longest track. Commands on the same track run in time order.
+** ================================================================================ */
+class Choreographer {
+
+    public:
+    static const std::size_t NUM_TRACKS = 4;
+
+
+    private:
+    /* ============================================================================
+    **  A command queued on a track, at seconds after the start of play().
+    ** ============================================================================ */
+    struct Cue {
+        double at;
+        std::function<bool()> action;
+    };
+
+    struct Worker {
+        std::thread      thread;
+        std::vector<Cue> cues;
+        bool pending;
+    };
+
+
+    /* ============================================================================
+    **  Internal members for the choreographer.
+    ** ============================================================================ */
+    Clock& _clock;
+    std::array<Worker, NUM_TRACKS> _workers;
+
+    std::mutex _lock;
+    std::condition_variable _wake, _done;
+
+    double _start;
+    double _length;
+    int    _busy;
+    bool   _ok;
+    bool   _stopping;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor. Starts one worker thread per track, each of which
+    **  first calls on_start (e.g. to set up real-time scheduling).
+    ** ============================================================================ */
+    Choreographer(Clock& clock, std::function<void()> on_start=nullptr);
+
+
+    /* ============================================================================
+    **  Destructor. Stops and joins the workers.
+    ** ============================================================================ */
+    ~Choreographer();
+
+
+    /* ============================================================================
+    **  Queue an action on a track.
+    **
+    ** @param track  : controller the action is for.
+    ** @param at     : seconds after the start of play() to run it.
+    ** @param action : the command; returns its success.
+    ** ============================================================================ */
+    void cue(Track track, double at, std::function<bool()> action);
+
+
+    /* ============================================================================
+    **  Make play() last at least until the given time, e.g. to let the last
+    **  motion finish.
+    ** ============================================================================ */
+    void until(double at);
+
+
+    /* ============================================================================
+    **  Run all queued actions and block until every track is done.
+    **
+    ** @return true if every action succeeded.
+    ** ============================================================================ */
+    bool play();
+
+
+    private:
+    /* ============================================================================
+    **  Worker loop for a single track.
+    ** ============================================================================ */
+    void run(std::size_t track, std::function<void()> on_start);
+
+};
+
+#endif /* CHOREOGRAPHER_HPP */
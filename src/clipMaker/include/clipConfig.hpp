@@ -0,0 +1,128 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef CLIP_CONFIG_HPP
+#define CLIP_CONFIG_HPP
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Searchable.h>
+
+#include <robot.hpp>
+#include <trajectory.hpp>
+
+
+/* ================================================================================
+**  The poses, timers and precomputed data the behaviors run from. A loaded
+**  config is never changed; reloading builds a new one and swaps it in, so a
+**  behavior keeps the snapshot it started with.
+** ================================================================================ */
+struct ClipConfig {
+
+    //-- Body vars.
+    std::vector<double> left_arm_home;
+    std::vector<double> right_arm_home;
+    std::vector<double> left_arm_right_peg;
+    std::vector<double> left_arm_mid_peg;
+    std::vector<double> right_arm_mid_peg;
+    std::vector<double> right_arm_left_peg;
+    double              body_speed;
+    double              body_home_timeout;
+
+    //-- Streamed (minjerk) body vars.
+    std::string body_mode;
+    double      body_traj_time;
+    double      body_stream_rate;
+    double      body_hold;
+    double      body_stagger;
+    bool        body_gaze;
+    double      body_start_tolerance;
+
+    //-- Expression vars.
+    double expr_timer;
+
+    //-- Gaze vars.
+    std::vector<double> gaze_home;
+    std::vector<double> gaze_left;
+    std::vector<double> gaze_mid;
+    std::vector<double> gaze_right;
+    double              gaze_speed;
+
+    //-- Speech vars. The pattern alternates mouth open/closed durations.
+    double spch_timer;
+    std::vector<double> spch_pattern;
+
+    //-- Built from the above. Trajectories are keyed by the poses of this 
+    //-- config, so build() must be called again on a copy.
+    std::map<std::pair<const std::vector<double>*, const std::vector<double>*>, Trajectory> trajectories;
+    std::map<std::string, FaceFrame> face_frames;
+
+
+    /* ============================================================================
+    **  Read the behavior vars from a config file or the command line.
+    **
+    ** @param conf       : where to read the vars from.
+    ** @param num_joints : joints per arm; minjerk poses need exactly this many.
+    ** @param strict     : reject the config if any joint positions are missing.
+    ** @param error      : set to what was wrong with the config, if anything.
+    **
+    ** @return false if the config can't be run with.
+    ** ============================================================================ */
+    bool load(yarp::os::Searchable& conf, const std::size_t num_joints, const bool strict, std::string& error);
+
+
+    /* ============================================================================
+    **  Precompute the trajectories (for minjerk) and face frames.
+    ** ============================================================================ */
+    void build();
+
+
+    /* ============================================================================
+    **  Look up the configured poses used by a behavior for a given peg.
+    ** ============================================================================ */
+    void bodyPoses(const int from, const int to, const std::vector<double>*& r_arm, const std::vector<double>*& l_arm) const;
+    const std::vector<double>* gazeTarget(const int peg) const;
+
+
+    /* ============================================================================
+    **  Get the precomputed trajectory between two poses of this config.
+    ** ============================================================================ */
+    const Trajectory& trajectory(const std::vector<double>& from, const std::vector<double>& to) const;
+
+
+    /* ============================================================================
+    **  Parse commands such as "set reb sur" into a single face frame.
+    ** ============================================================================ */
+    static FaceFrame makeFaceFrame(const std::vector<std::string> msgs);
+
+
+    /* ============================================================================
+    **  
+    ** ============================================================================ */
+    static bool loadBottleAsVec(yarp::os::Bottle* bot, std::vector<double>& vec);
+
+
+    private:
+    /* ============================================================================
+    **  Compute and store the trajectory between two poses.
+    ** ============================================================================ */
+    void addTrajectory(const std::vector<double>& from, const std::vector<double>& to);
+
+};
+
+#endif /* CLIP_CONFIG_HPP */
@@ -18,16 +18,27 @@
 //#include <map>
 //#include <memory>
 
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <sys/stat.h>
+
 #include <yarp/os/Network.h>
 
 #include <yarp/os/Bottle.h>
+#include <yarp/os/BufferedPort.h>
 #include <yarp/os/LogStream.h>
+#include <yarp/os/Property.h>
 #include <yarp/os/RFModule.h>
 #include <yarp/os/RpcClient.h>
 #include <yarp/os/Time.h>
@@ -36,9 +47,28 @@
 #include <yarp/dev/GazeControl.h>
 #include <yarp/dev/PolyDriver.h>
 
+#include <choreographer.hpp>
+#include <clipConfig.hpp>
+#include <clipManifest.hpp>
+#include <clock.hpp>
+#include <eventLog.hpp>
+#include <executor.hpp>
+#include <fakeRobot.hpp>
+#include <jitterStats.hpp>
+#include <jobQueue.hpp>
+#include <loggedRobot.hpp>
+#include <realtime.hpp>
+#include <robot.hpp>
+#include <trajectory.hpp>
+#include <yarpRobot.hpp>
+
 
 class ClipMaker : public yarp::os::RFModule {
 
+    //-- The tests drive the private behavior paths directly.
+    friend class ClipMakerTest;
+
+
     private:
     /* ============================================================================
     **  Yarp RPC server for sending commands and receiving responses.
@@ -46,57 +76,79 @@ class ClipMaker : public yarp::os::RFModule {
     yarp::os::RpcServer _rpc;
     std::string _module_name;
     std::string _robot_name;
+    std::string _gaze_remote;
+    std::string _backend;
 
-    //-- Body vars.
-    std::vector<double> _left_arm_home;
-    std::vector<double> _right_arm_home;
-    std::vector<double> _left_arm_right_peg;
-    std::vector<double> _left_arm_mid_peg;
-    std::vector<double> _right_arm_mid_peg;
-    std::vector<double> _right_arm_left_peg;
-    std::size_t         _num_joints;
-    double              _body_speed;
-
-    //-- Expression vars.
-    double _expr_timer;
+    //-- Body vars fixed for the lifetime of the robots.
+    std::size_t _num_joints;
 
-    //-- Gaze vars.
-    std::vector<double> _gaze_home;
-    std::vector<double> _gaze_left;
-    std::vector<double> _gaze_mid;
-    std::vector<double> _gaze_right;
+    //-- Behavior vars, swapped as a whole by ``reload``. Use config() to get
+    //-- a snapshot that stays valid for the rest of a behavior.
+    std::shared_ptr<const ClipConfig> _config;
+    std::string _config_file;
+    yarp::os::Property _command_line;
+    bool        _config_watch;
+    time_t      _config_mtime;
 
-    double _gaze_speed;
+    //-- Clip library vars.
+    std::string  _clip_path;
+    std::string  _timeline_path;
+    ClipManifest _manifest;
 
-    //-- Speech vars.
-    double _spch_timer;
+    //-- Event log vars.
+    std::size_t _event_capacity;
+    bool        _events_port;
 
 
     /* ============================================================================
-    **  Yarp ports for controlling behavior flow of interface.
+    **  One simulator (or fake) the behaviors can be run against.
     ** ============================================================================ */
-    yarp::dev::PolyDriver _left_arm, _right_arm;
+    struct Instance {
+        std::string tag;
+        std::unique_ptr<Robot> robot;
+        FakeRobot* fake_robot; // set when the fake backend is in use.
+        std::unique_ptr<Choreographer> choreo;
+        std::unique_ptr<Executor> executor; // thread the behaviors run on.
+        std::mutex lock;
+        JitterStats jitter; // of the last behavior's periodic loop.
+        std::unique_ptr<EventLog> events; // commands sent by the last behavior.
+        yarp::os::BufferedPort<yarp::os::Bottle> events_port;
+        std::shared_ptr<const ClipConfig> applied; // config the speeds were set from.
+    };
 
-    yarp::dev::IPositionControl* _left_arm_pos;
-    yarp::dev::IPositionControl* _right_arm_pos;
 
-    yarp::dev::PolyDriver _gaze_client;
-    yarp::dev::IGazeControl* _gaze;
-    int _gaze_startup_context;
+    /* ============================================================================
+    **  Clock shared by all instances. The first instance is the one driven by
+    **  ``home`` and ``beh``; ``batch`` spreads its clips over all of them.
+    ** ============================================================================ */
+    std::unique_ptr<Clock> _clock;
+    std::vector<std::unique_ptr<Instance>> _instances;
+
 
-    yarp::os::Port _expr_port;
+    /* ============================================================================
+    **  Optional real-time scheduling for the behavior and choreographer threads.
+    ** ============================================================================ */
+    RealtimeConfig _rt;
 
-    //yarp::os::Port _body_port;
-    //yarp::os::Port _gaze_port;
+    //-- Longest rtbench loop, in seconds; it runs twice, blocking the rpc port.
+    static constexpr double RTBENCH_MAX_TIME = 30.0;
 
 
     /* ============================================================================
     **  Control variables for the interface.
     ** ============================================================================ */
-    std::mutex lock;
+    std::mutex _manifest_lock;
+    std::mutex _reload_lock;
 
 
     public:
+    /* ============================================================================
+    **  Keep the command line options, so they still override the config file
+    **  when it is reloaded. Call before runModule.
+    ** ============================================================================ */
+    void setCommandLine(int argc, char** argv);
+
+
     /* ============================================================================
     **  Configure the resource finder module.
     **
@@ -142,25 +194,128 @@ class ClipMaker : public yarp::os::RFModule {
 
 
     private:
+    /* ============================================================================
+    **  Get the current config snapshot.
+    ** ============================================================================ */
+    std::shared_ptr<const ClipConfig> config();
+
+
+    /* ============================================================================
+    **  Parse a new config snapshot and swap it in. Running behaviors finish
+    **  with the old one; the robots and ports are left as they are.
+    **
+    ** @param conf   : config file or command line to read from.
+    ** @param strict : refuse the config if any joint positions are missing.
+    **
+    ** @return success of loading the config.
+    ** ============================================================================ */
+    bool loadConfig(yarp::os::Searchable& conf, const bool strict);
+
+
+    /* ============================================================================
+    **  Re-read the config file (or the given one) and swap it in.
+    ** ============================================================================ */
+    bool reloadConfig(const std::string fname);
+
+
+    /* ============================================================================
+    **  Set the speeds of an instance from a config, if not done already.
+    ** ============================================================================ */
+    void applyConfig(Instance& inst, const std::shared_ptr<const ClipConfig>& cfg);
+
+
     /* ============================================================================
     **  
     ** ============================================================================ */
-    bool runHome();
+    bool runHome(Instance& inst);
+
+
+    /* ============================================================================
+    **  Create and open the robot of a new instance for the chosen backend.
+    ** ============================================================================ */
+    bool addInstance(const std::string tag, const std::string robot_name, const std::string gaze_remote);
 
 
     /* ============================================================================
     **  
     ** ============================================================================ */
-    bool runBehavior(const std::string behavior, const int from, const int to);
+    bool runBehavior(Instance& inst, const std::shared_ptr<const ClipConfig>& cfg, const std::string behavior, const int from, const int to);
+
+
+    /* ============================================================================
+    **  Write the event log of a finished behavior next to its clip and
+    **  publish it on the instance's events port.
+    ** ============================================================================ */
+    void flushEvents(Instance& inst, const std::string behavior, const int from, const int to);
+
+
+    /* ============================================================================
+    **  Run every behavior whose clip is missing from the manifest or was
+    **  generated from different config values. Regenerated keys are added
+    **  to the reply.
+    **
+    ** @param force  regenerate every clip regardless of the manifest.
+    ** ============================================================================ */
+    bool runBatch(const bool force, yarp::os::Bottle& reply);
+
+
+    /* ============================================================================
+    **  Worker for runBatch: run jobs on one instance until the queue is dry.
+    ** ============================================================================ */
+    bool batchWorker(std::size_t idx, JobQueue& queue, std::vector<std::string>& done);
+
+
+    /* ============================================================================
+    **  Run a periodic loop on a plain thread and on a real-time one, adding
+    **  the lateness of each to the reply for comparison. Blocks for twice
+    **  iterations times period.
+    **
+    ** @param iterations : number of periods to run.
+    ** @param period     : seconds between deadlines.
+    ** ============================================================================ */
+    bool rtBenchmark(const int iterations, const double period, yarp::os::Bottle& reply);
+
+
+    /* ============================================================================
+    **  Thread setup hook handed to the executors and choreographers.
+    ** ============================================================================ */
+    void setupThread();
+
+
+    /* ============================================================================
+    **  Build a canonical string of the config values a behavior uses for the
+    **  given from/to, so that its hash changes only when the clip would.
+    ** ============================================================================ */
+    std::string behaviorSignature(const ClipConfig& cfg, const std::string behavior, const int from, const int to);
 
 
     /* ============================================================================
     **  
     ** ============================================================================ */
-    bool body(const int from, const int to);
-    bool expression(const int from, const int to);
-    bool gaze(const int from, const int to);
-    bool speech();
+    bool body(Instance& inst, const ClipConfig& cfg, const int from, const int to);
+    bool expression(Instance& inst, const ClipConfig& cfg, const int from, const int to);
+    bool gaze(Instance& inst, const ClipConfig& cfg, const int from, const int to);
+    bool speech(Instance& inst, const ClipConfig& cfg);
+
+
+    /* ============================================================================
+    **  Queue an arm move from one pose to another on the arm's track, as a
+    **  positionMove or a streamed trajectory depending on body_mode.
+    ** ============================================================================ */
+    void cueArm(Instance& inst, const ClipConfig& cfg, Limb limb, double at, const std::vector<double>& from, const std::vector<double>& to);
+
+
+    /* ============================================================================
+    **  Stream a trajectory to one arm at body_stream_rate (blocking).
+    ** ============================================================================ */
+    bool streamTrajectory(Instance& inst, const ClipConfig& cfg, Limb limb, const Trajectory& traj);
+
+
+    /* ============================================================================
+    **  Check that an arm's encoders are within body_start_tolerance of the start
+    **  of a trajectory, so that streaming it doesn't jerk the arm there.
+    ** ============================================================================ */
+    bool atStart(Instance& inst, const ClipConfig& cfg, Limb limb, const Trajectory& traj);
 
 
     /* ============================================================================
@@ -170,15 +325,15 @@ class ClipMaker : public yarp::os::RFModule {
 
 
     /* ============================================================================
-    **  
+    **  Send a compiled face frame by name.
     ** ============================================================================ */
-    void sendMessage(yarp::os::Port& port, const std::string msg);
+    void sendFrame(Instance& inst, const ClipConfig& cfg, const std::string name);
 
 
     /* ============================================================================
-    **  
+    **  Queue a compiled face frame by name on the face track.
     ** ============================================================================ */
-    bool loadBottleAsVec(yarp::os::Bottle* bot, std::vector<double>& vec);
+    void cueFrame(Instance& inst, const ClipConfig& cfg, double at, const std::string name);
 
 };
 
@@ -0,0 +1,94 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef CLIP_MANIFEST_HPP
+#define CLIP_MANIFEST_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+
+class ClipManifest {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the manifest.
+    ** ============================================================================ */
+    std::map<std::string, std::string> _entries; // key -> hash.
+    std::map<std::string, std::string> _tags;    // key -> instance that made it.
+    std::string _fname;
+    bool _opened;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    ClipManifest();
+
+
+    /* ============================================================================
+    **  Destructor.
+    ** ============================================================================ */
+    ~ClipManifest();
+
+
+    /* ============================================================================
+    **  Open the manifest, loading any entries already written to it.
+    **
+    ** @param fname  file name of the manifest (need not exist yet).
+    **
+    ** @return success of reading the existing manifest.
+    ** ============================================================================ */
+    bool openManifest(std::string fname);
+
+
+    /* ============================================================================
+    **  Write all entries back out to the manifest file.
+    **
+    ** @return success of writing the file.
+    ** ============================================================================ */
+    bool saveManifest();
+
+
+    /* ============================================================================
+    **  Check if the clip under key was generated with the given hash.
+    ** ============================================================================ */
+    bool isCurrent(std::string key, std::string hash);
+
+
+    /* ============================================================================
+    **  Record the hash that the clip under key was generated with, and the tag
+    **  of the instance that generated it.
+    ** ============================================================================ */
+    void update(std::string key, std::string hash, std::string tag="");
+
+
+    /* ============================================================================
+    **  Build the manifest key for a (behavior, from, to) clip.
+    ** ============================================================================ */
+    static std::string makeKey(std::string behavior, int from, int to);
+
+
+    /* ============================================================================
+    **  Hash the content string (64-bit FNV-1a) and return it as hex.
+    ** ============================================================================ */
+    static std::string hash(const std::string& content);
+
+};
+
+#endif /* CLIP_MANIFEST_HPP */
@@ -0,0 +1,100 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include <time.h>
+
+
+/* ================================================================================
+**  Source of time for the behaviors. Everything that waits or stamps goes
+**  through one of these so behaviors can run faster than real time.
+** ================================================================================ */
+class Clock {
+
+    public:
+    /* ============================================================================
+    **  Destructor.
+    ** ============================================================================ */
+    virtual ~Clock() {}
+
+
+    /* ============================================================================
+    **  Get the current time in seconds.
+    ** ============================================================================ */
+    virtual double now() = 0;
+
+
+    /* ============================================================================
+    **  Block for the given number of seconds.
+    ** ============================================================================ */
+    virtual void delay(double seconds) = 0;
+
+
+    /* ============================================================================
+    **  Block until the clock reads the given time. Periodic loops should step
+    **  an absolute deadline and wait on it, so that late wake ups don't add up.
+    ** ============================================================================ */
+    virtual void delayUntil(double deadline) = 0;
+
+};
+
+
+/* ================================================================================
+**  Monotonic system clock. Waits use clock_nanosleep with absolute deadlines.
+** ================================================================================ */
+class SystemClock : public Clock {
+
+    public:
+    double now();
+    void delay(double seconds);
+    void delayUntil(double deadline);
+
+};
+
+
+/* ================================================================================
+**  Clock that runs ``warp`` times faster than the wall clock. Both now() and
+**  delay() are in virtual seconds, so behavior timing reads the same as it
+**  would at 1x.
+** ================================================================================ */
+class VirtualClock : public Clock {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the clock.
+    ** ============================================================================ */
+    std::chrono::steady_clock::time_point _epoch;
+    double _warp;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param warp : time-warp factor (> 0), e.g. 10 runs ten times faster.
+    ** ============================================================================ */
+    VirtualClock(double warp=1.0);
+
+    double now();
+    void delay(double seconds);
+    void delayUntil(double deadline);
+
+};
+
+#endif /* CLOCK_HPP */
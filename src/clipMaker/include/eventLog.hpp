@@ -0,0 +1,130 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+
+
+/* ================================================================================
+**  What an event was sent to, and which command it was.
+** ================================================================================ */
+enum class EventTarget : uint8_t { LeftArm, RightArm, Gaze, Face };
+enum class EventCommand : uint8_t { SetRefSpeed, PositionMove, SetControlMode, SetPositions, SetTrajTime, LookAt, Write };
+
+
+/* ================================================================================
+**  One outgoing command. Fixed size so the log never allocates while a
+**  behavior runs; arguments beyond MAX_VALUES or MAX_TEXT are cut off.
+** ================================================================================ */
+struct Event {
+    static constexpr std::size_t MAX_VALUES = 32;
+    static constexpr std::size_t MAX_TEXT   = 64;
+
+    double       stamp;   // seconds since the log was started.
+    EventTarget  target;
+    EventCommand command;
+    uint16_t     count;   // number of values used.
+    double       values[MAX_VALUES];
+    char         text[MAX_TEXT];
+};
+
+
+/* ================================================================================
+**  Preallocated log of the commands sent during one behavior. Any thread may
+**  record; start, write and addTo must only be called while none are.
+** ================================================================================ */
+class EventLog {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the log.
+    ** ============================================================================ */
+    std::vector<Event>       _events;
+    std::atomic<std::size_t> _next;
+
+    double _start;      // clock time of start().
+    double _start_wall; // unix time of start(), for lining up with video.
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param capacity : events per behavior; later ones are counted as dropped.
+    ** ============================================================================ */
+    EventLog(std::size_t capacity);
+
+
+    /* ============================================================================
+    **  Clear the log and restart its time base.
+    **
+    ** @param now : current time of the clock events are stamped with.
+    ** ============================================================================ */
+    void start(double now);
+
+
+    /* ============================================================================
+    **  Record one command.
+    **
+    ** @param now    : current time of the clock, as passed to start().
+    ** @param values : numeric arguments, may be null if count is 0.
+    ** @param text   : text argument, may be null.
+    ** ============================================================================ */
+    void record(double now, EventTarget target, EventCommand command, 
+        const double* values, std::size_t count, const char* text=nullptr);
+
+
+    /* ============================================================================
+    **  Number of events recorded, and dropped for lack of space, since start().
+    ** ============================================================================ */
+    std::size_t size() const;
+    std::size_t dropped() const;
+
+
+    /* ============================================================================
+    **  Write the log as a sidecar file, one event per line.
+    **
+    ** @param fname : file name, e.g. next to the clip.
+    ** @param tag   : instance the behavior ran on.
+    **
+    ** @return success of writing the file.
+    ** ============================================================================ */
+    bool write(const std::string fname, const std::string tag) const;
+
+
+    /* ============================================================================
+    **  Add the log to a bottle as 
+    **  ``key tag start start_wall (stamp target command args...) ...``.
+    ** ============================================================================ */
+    void addTo(yarp::os::Bottle& bot, const std::string key, const std::string tag) const;
+
+
+    /* ============================================================================
+    **  Get printable names for a target and command.
+    ** ============================================================================ */
+    static const char* targetName(EventTarget target);
+    static const char* commandName(EventCommand command);
+
+};
+
+#endif /* EVENT_LOG_HPP */
@@ -0,0 +1,74 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+
+/* ================================================================================
+**  A single thread that runs submitted jobs in order. Behaviors run here
+**  instead of on the RPC thread, so the thread can be set up for real time.
+** ================================================================================ */
+class Executor {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the executor.
+    ** ============================================================================ */
+    std::thread _thread;
+    std::mutex  _lock;
+    std::condition_variable _wake;
+    std::deque<std::packaged_task<bool()>> _jobs;
+    bool _stopping;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor. Starts the thread, which first calls on_start.
+    ** ============================================================================ */
+    Executor(std::function<void()> on_start=nullptr);
+
+
+    /* ============================================================================
+    **  Destructor. Finishes the queued jobs and joins the thread.
+    ** ============================================================================ */
+    ~Executor();
+
+
+    /* ============================================================================
+    **  Queue a job; the future holds its result once it has run.
+    ** ============================================================================ */
+    std::future<bool> submit(std::function<bool()> job);
+
+
+    /* ============================================================================
+    **  Run a job and block until it is done.
+    ** ============================================================================ */
+    bool run(std::function<bool()> job);
+
+
+    private:
+    /* ============================================================================
+    **  Thread loop.
+    ** ============================================================================ */
+    void loop(std::function<void()> on_start);
+
+};
+
+#endif /* EXECUTOR_HPP */
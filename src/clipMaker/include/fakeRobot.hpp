@@ -0,0 +1,126 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef FAKE_ROBOT_HPP
+#define FAKE_ROBOT_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+
+#include <clock.hpp>
+#include <robot.hpp>
+
+
+/* ================================================================================
+**  One command as issued to the fake robot.
+** ================================================================================ */
+struct TimelineEntry {
+    double      stamp;    // seconds since the timeline was started.
+    std::string target;   // left_arm, right_arm, gaze or face.
+    std::string command;  // name of the command.
+    std::string args;     // arguments, space separated.
+};
+
+
+/* ================================================================================
+**  Robot with no devices behind it. Every command is recorded, stamped by the
+**  clock, into a timeline that can be written out and diffed between runs.
+**  The arms start at zero and reach every commanded position at once.
+** ================================================================================ */
+class FakeRobot : public Robot {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the fake robot.
+    ** ============================================================================ */
+    Clock& _clock;
+    int    _num_joints;
+
+    std::mutex _positions_lock;
+    std::vector<double> _left_arm_positions, _right_arm_positions;
+
+    std::mutex _timeline_lock;
+    std::vector<TimelineEntry> _timeline;
+    double _timeline_start;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param clock      : clock used to stamp the commands.
+    ** @param num_joints : number of joints per arm.
+    ** ============================================================================ */
+    FakeRobot(Clock& clock, int num_joints);
+
+    bool open();
+    void interrupt();
+    void close();
+
+    bool setRefSpeed(double speed);
+    bool positionMove(Limb limb, const double* pos);
+    bool hasPositionDirect();
+    bool setDirectMode(Limb limb, bool direct);
+    bool setPositions(Limb limb, const double* pos);
+    bool getPositions(Limb limb, double* pos);
+    bool checkMotionDone(Limb limb, bool& done);
+    bool setGazeTrajTime(double neck, double eyes);
+    bool lookAtAbsAngles(const yarp::sig::Vector& ang);
+    bool sendFace(const FaceFrame& frame);
+
+
+    /* ============================================================================
+    **  Clear the timeline and restart its time base.
+    ** ============================================================================ */
+    void startTimeline();
+
+
+    /* ============================================================================
+    **  Get a copy of the commands recorded since startTimeline().
+    ** ============================================================================ */
+    std::vector<TimelineEntry> getTimeline();
+
+
+    /* ============================================================================
+    **  Write the timeline, one command per line.
+    **
+    ** @param fname  file name for the timeline.
+    ** @param tag    instance the timeline was recorded on.
+    **
+    ** @return success of writing the file.
+    ** ============================================================================ */
+    bool writeTimeline(std::string fname, std::string tag="");
+
+
+    private:
+    /* ============================================================================
+    **  Put a limb at the given position.
+    ** ============================================================================ */
+    void moveTo(Limb limb, const double* pos);
+
+
+    /* ============================================================================
+    **  Append a command to the timeline.
+    ** ============================================================================ */
+    void record(std::string target, std::string command, std::string args);
+
+};
+
+#endif /* FAKE_ROBOT_HPP */
@@ -0,0 +1,74 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef JITTER_STATS_HPP
+#define JITTER_STATS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+#include <yarp/os/Bottle.h>
+
+
+/* ================================================================================
+**  Running statistics of how late a periodic loop woke up after each deadline.
+** ================================================================================ */
+class JitterStats {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the stats (Welford's running mean/variance).
+    ** ============================================================================ */
+    std::size_t _count;
+    double _mean;
+    double _m2;
+    double _max;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    JitterStats();
+
+
+    /* ============================================================================
+    **  Forget every sample.
+    ** ============================================================================ */
+    void clear();
+
+
+    /* ============================================================================
+    **  Add how late (seconds) a wake up was compared to its deadline.
+    ** ============================================================================ */
+    void add(double lateness);
+
+
+    /* ============================================================================
+    **  Accessors, all in seconds.
+    ** ============================================================================ */
+    std::size_t count() const;
+    double mean() const;
+    double max() const;
+    double stddev() const;
+
+
+    /* ============================================================================
+    **  Append the stats to a reply as ``(<name> n <n> mean <s> max <s> std <s>)``.
+    ** ============================================================================ */
+    void addTo(yarp::os::Bottle& reply, const std::string name) const;
+
+};
+
+#endif /* JITTER_STATS_HPP */
@@ -0,0 +1,73 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef JOB_QUEUE_HPP
+#define JOB_QUEUE_HPP
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+/* ================================================================================
+**  A clip to (re)generate during a batch.
+** ================================================================================ */
+struct ClipJob {
+    std::string behavior;
+    int from;
+    int to;
+    std::string key;   // manifest key.
+    std::string hash;  // hash of the config values the clip is made from.
+};
+
+
+/* ================================================================================
+**  Work-stealing queue of clip jobs. Each worker takes from the front of its
+**  own deque and, once that is empty, steals from the back of the others.
+** ================================================================================ */
+class JobQueue {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the queue.
+    ** ============================================================================ */
+    std::vector<std::deque<ClipJob>>         _queues;
+    std::vector<std::unique_ptr<std::mutex>> _locks;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param num_workers : number of workers (and deques).
+    ** ============================================================================ */
+    JobQueue(std::size_t num_workers);
+
+
+    /* ============================================================================
+    **  Add a job to the back of a worker's deque.
+    ** ============================================================================ */
+    void push(std::size_t worker, const ClipJob& job);
+
+
+    /* ============================================================================
+    **  Get the next job for a worker, stealing if its own deque is empty.
+    **
+    ** @return false once every deque is empty.
+    ** ============================================================================ */
+    bool pop(std::size_t worker, ClipJob& job);
+
+};
+
+#endif /* JOB_QUEUE_HPP */
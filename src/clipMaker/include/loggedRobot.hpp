@@ -0,0 +1,77 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef LOGGED_ROBOT_HPP
+#define LOGGED_ROBOT_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <clock.hpp>
+#include <eventLog.hpp>
+#include <robot.hpp>
+
+
+/* ================================================================================
+**  Wraps another robot, stamping every command into an event log just before
+**  it is passed on. Reads are passed on without being logged.
+** ================================================================================ */
+class LoggedRobot : public Robot {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the logged robot.
+    ** ============================================================================ */
+    std::unique_ptr<Robot> _robot;
+    EventLog& _log;
+    Clock&    _clock;
+    int       _num_joints;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param robot      : robot the commands go to (owned).
+    ** @param log        : log to record into.
+    ** @param clock      : clock used to stamp the commands.
+    ** @param num_joints : number of joints per arm.
+    ** ============================================================================ */
+    LoggedRobot(Robot* robot, EventLog& log, Clock& clock, int num_joints);
+
+    bool open();
+    void interrupt();
+    void close();
+
+    bool setRefSpeed(double speed);
+    bool positionMove(Limb limb, const double* pos);
+    bool hasPositionDirect();
+    bool setDirectMode(Limb limb, bool direct);
+    bool setPositions(Limb limb, const double* pos);
+    bool getPositions(Limb limb, double* pos);
+    bool checkMotionDone(Limb limb, bool& done);
+    bool setGazeTrajTime(double neck, double eyes);
+    bool lookAtAbsAngles(const yarp::sig::Vector& ang);
+    bool sendFace(const FaceFrame& frame);
+
+
+    private:
+    /* ============================================================================
+    **  Get the event target for a limb.
+    ** ============================================================================ */
+    static EventTarget limbTarget(Limb limb);
+
+};
+
+#endif /* LOGGED_ROBOT_HPP */
@@ -0,0 +1,90 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef REALTIME_HPP
+#define REALTIME_HPP
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <yarp/os/LogStream.h>
+
+
+/* ================================================================================
+**  Settings for running behaviors with real-time scheduling.
+** ================================================================================ */
+struct RealtimeConfig {
+    bool enabled       = false;
+    int  priority      = 80;       // SCHED_FIFO priority.
+    std::vector<int> cpus;         // CPU affinity, empty for any.
+    bool lock_memory   = true;     // mlockall current and future pages.
+    std::size_t prefault_stack = 512 * 1024;       // bytes per thread.
+    std::size_t prefault_heap  = 64 * 1024 * 1024; // bytes for the process.
+};
+
+
+/* ================================================================================
+**  Helpers to apply a RealtimeConfig. Each step warns and carries on when it
+**  isn't permitted (e.g. no CAP_SYS_NICE or RLIMIT_MEMLOCK too low).
+** ================================================================================ */
+class Realtime {
+
+    public:
+    //-- Prefaulted with alloca, so well within the default 8 MB thread stack.
+    static const std::size_t MAX_PREFAULT_STACK = 4 * 1024 * 1024;
+
+
+    /* ============================================================================
+    **  Check the settings are in range before any of them are applied.
+    **
+    ** @param error : set to the first setting out of range.
+    **
+    ** @return false if a setting is out of range.
+    ** ============================================================================ */
+    static bool check(const RealtimeConfig& cfg, std::string& error);
+
+
+    /* ============================================================================
+    **  Lock memory and prefault the heap. Call once, early, from the main thread.
+    **
+    ** @return true if every step succeeded.
+    ** ============================================================================ */
+    static bool setupProcess(const RealtimeConfig& cfg);
+
+
+    /* ============================================================================
+    **  Give the calling thread SCHED_FIFO priority, CPU affinity and a
+    **  prefaulted stack.
+    **
+    ** @return true if every step succeeded.
+    ** ============================================================================ */
+    static bool setupThread(const RealtimeConfig& cfg);
+
+
+    private:
+    /* ============================================================================
+    **  Touch size bytes of the stack so the pages are resident before use.
+    ** ============================================================================ */
+    static void prefaultStack(std::size_t size);
+
+};
+
+#endif /* REALTIME_HPP */
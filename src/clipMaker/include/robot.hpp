@@ -0,0 +1,137 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef ROBOT_HPP
+#define ROBOT_HPP
+
+#include <string>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/sig/Vector.h>
+
+
+/* ================================================================================
+**  The limbs a behavior can move.
+** ================================================================================ */
+enum class Limb { LeftArm, RightArm };
+
+
+/* ================================================================================
+**  One face change: the command bottles for each part, sent back to back.
+** ================================================================================ */
+typedef std::vector<yarp::os::Bottle> FaceFrame;
+
+
+/* ================================================================================
+**  Everything a behavior may command on the robot. Implemented over the real
+**  devices by YarpRobot, and by FakeRobot for running without a simulator.
+** ================================================================================ */
+class Robot {
+
+    public:
+    /* ============================================================================
+    **  Destructor.
+    ** ============================================================================ */
+    virtual ~Robot() {}
+
+
+    /* ============================================================================
+    **  Open the devices and ports behind the robot.
+    **
+    ** @return success status of opening.
+    ** ============================================================================ */
+    virtual bool open() = 0;
+
+
+    /* ============================================================================
+    **  Stop any motion and interrupt the ports.
+    ** ============================================================================ */
+    virtual void interrupt() = 0;
+
+
+    /* ============================================================================
+    **  Close the devices and ports.
+    ** ============================================================================ */
+    virtual void close() = 0;
+
+
+    /* ============================================================================
+    **  Set the reference speed for every joint of both arms.
+    ** ============================================================================ */
+    virtual bool setRefSpeed(double speed) = 0;
+
+
+    /* ============================================================================
+    **  Move all joints of a limb to the given position.
+    ** ============================================================================ */
+    virtual bool positionMove(Limb limb, const double* pos) = 0;
+
+
+    /* ============================================================================
+    **  Check if the limbs can be streamed to in position-direct mode.
+    ** ============================================================================ */
+    virtual bool hasPositionDirect() = 0;
+
+
+    /* ============================================================================
+    **  Switch a limb between position-direct (streaming) and position mode.
+    ** ============================================================================ */
+    virtual bool setDirectMode(Limb limb, bool direct) = 0;
+
+
+    /* ============================================================================
+    **  Stream all joints of a limb to the given position (position-direct).
+    ** ============================================================================ */
+    virtual bool setPositions(Limb limb, const double* pos) = 0;
+
+
+    /* ============================================================================
+    **  Read the measured position of all joints of a limb (encoders).
+    ** ============================================================================ */
+    virtual bool getPositions(Limb limb, double* pos) = 0;
+
+
+    /* ============================================================================
+    **  Check if a limb has finished its last positionMove.
+    ** ============================================================================ */
+    virtual bool checkMotionDone(Limb limb, bool& done) = 0;
+
+
+    /* ============================================================================
+    **  Set the neck and eye trajectory times of the gaze controller.
+    ** ============================================================================ */
+    virtual bool setGazeTrajTime(double neck, double eyes) = 0;
+
+
+    /* ============================================================================
+    **  Look at the given absolute (azimuth, elevation, vergence) angles.
+    ** ============================================================================ */
+    virtual bool lookAtAbsAngles(const yarp::sig::Vector& ang) = 0;
+
+
+    /* ============================================================================
+    **  Send a face frame to the face expression module in one go.
+    ** ============================================================================ */
+    virtual bool sendFace(const FaceFrame& frame) = 0;
+
+
+    /* ============================================================================
+    **  Get a printable name of a limb.
+    ** ============================================================================ */
+    static std::string limbName(Limb limb) {
+        return (limb == Limb::LeftArm ? "left_arm" : "right_arm");
+    }
+
+};
+
+#endif /* ROBOT_HPP */
@@ -0,0 +1,74 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+/* ================================================================================
+**  Minimum-jerk joint trajectory between two poses, sampled at a fixed period.
+** ================================================================================ */
+class Trajectory {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the trajectory.
+    ** ============================================================================ */
+    std::vector<double> _samples; // row-major, one row of joints per sample.
+    std::size_t _num_joints;
+    std::size_t _num_samples;
+    double _duration;
+    double _period;
+
+
+    public:
+    /* ============================================================================
+    **  Default Constructor (empty trajectory).
+    ** ============================================================================ */
+    Trajectory();
+
+
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param from     : starting joint positions.
+    ** @param to       : final joint positions (same size as from).
+    ** @param duration : time to go from start to finish, in seconds.
+    ** @param period   : time between samples, in seconds.
+    ** ============================================================================ */
+    Trajectory(const std::vector<double>& from, const std::vector<double>& to, double duration, double period);
+
+
+    /* ============================================================================
+    **  Get the joint positions at time t, clamped to the ends of the trajectory.
+    ** ============================================================================ */
+    const double* at(double t) const;
+
+
+    /* ============================================================================
+    **  Get the duration of the trajectory in seconds.
+    ** ============================================================================ */
+    double duration() const;
+
+
+    /* ============================================================================
+    **  Get the number of samples in the trajectory.
+    ** ============================================================================ */
+    std::size_t size() const;
+
+};
+
+#endif /* TRAJECTORY_HPP */
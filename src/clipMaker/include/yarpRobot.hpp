@@ -0,0 +1,93 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef YARP_ROBOT_HPP
+#define YARP_ROBOT_HPP
+
+#include <string>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/BufferedPort.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Property.h>
+
+#include <yarp/dev/ControlBoardInterfaces.h>
+#include <yarp/dev/GazeControl.h>
+#include <yarp/dev/PolyDriver.h>
+
+#include <robot.hpp>
+
+
+class YarpRobot : public Robot {
+
+    private:
+    /* ============================================================================
+    **  Names used for connecting to the robot.
+    ** ============================================================================ */
+    std::string _local_name;
+    std::string _robot_name;
+    std::string _gaze_remote;
+    int         _num_joints;
+
+
+    /* ============================================================================
+    **  Devices and ports.
+    ** ============================================================================ */
+    yarp::dev::PolyDriver _left_arm, _right_arm;
+
+    yarp::dev::IPositionControl* _left_arm_pos;
+    yarp::dev::IPositionControl* _right_arm_pos;
+
+    yarp::dev::IEncoders* _left_arm_enc;
+    yarp::dev::IEncoders* _right_arm_enc;
+
+    yarp::dev::IPositionDirect* _left_arm_dir;
+    yarp::dev::IPositionDirect* _right_arm_dir;
+    yarp::dev::IControlMode*    _left_arm_mode;
+    yarp::dev::IControlMode*    _right_arm_mode;
+
+    yarp::dev::PolyDriver _gaze_client;
+    yarp::dev::IGazeControl* _gaze;
+    int _gaze_startup_context;
+
+    yarp::os::BufferedPort<yarp::os::Bottle> _expr_port;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param local_name  : prefix for the local ports (the module name).
+    ** @param robot_name  : name of the robot, e.g. icubSim.
+    ** @param gaze_remote : name of the gaze controller, e.g. /iKinGazeCtrl.
+    ** @param num_joints  : number of joints per arm.
+    ** ============================================================================ */
+    YarpRobot(std::string local_name, std::string robot_name, std::string gaze_remote, int num_joints);
+
+    bool open();
+    void interrupt();
+    void close();
+
+    bool setRefSpeed(double speed);
+    bool positionMove(Limb limb, const double* pos);
+    bool hasPositionDirect();
+    bool setDirectMode(Limb limb, bool direct);
+    bool setPositions(Limb limb, const double* pos);
+    bool getPositions(Limb limb, double* pos);
+    bool checkMotionDone(Limb limb, bool& done);
+    bool setGazeTrajTime(double neck, double eyes);
+    bool lookAtAbsAngles(const yarp::sig::Vector& ang);
+    bool sendFace(const FaceFrame& frame);
+
+};
+
+#endif /* YARP_ROBOT_HPP */
@@ -0,0 +1,124 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <choreographer.hpp>
+
+
+Choreographer::Choreographer(Clock& clock, std::function<void()> on_start/*=nullptr*/) :
+    _clock(clock), _start(0.0), _length(0.0), _busy(0), _ok(true), _stopping(false) {
+
+    for (std::size_t track = 0; track < NUM_TRACKS; ++track) {
+        _workers[track].pending = false;
+        _workers[track].thread  = std::thread(&Choreographer::run, this, track, on_start);
+    }
+
+    return;
+}
+
+
+Choreographer::~Choreographer() {
+
+    {
+        std::lock_guard<std::mutex> lg(_lock);
+        _stopping = true;
+    }
+    _wake.notify_all();
+
+    for (Worker& worker : _workers) {
+        if (worker.thread.joinable()) worker.thread.join();
+    }
+}
+
+
+void Choreographer::cue(Track track, double at, std::function<bool()> action) {
+    std::lock_guard<std::mutex> lg(_lock);
+    _workers[static_cast<std::size_t>(track)].cues.push_back({ at, action });
+    return;
+}
+
+
+void Choreographer::until(double at) {
+    std::lock_guard<std::mutex> lg(_lock);
+    _length = std::max(_length, at);
+    return;
+}
+
+
+bool Choreographer::play() {
+
+    std::unique_lock<std::mutex> lk(_lock);
+
+    //-- Hand every track with work to its worker, all against one start time.
+    _ok    = true;
+    _start = _clock.now();
+    for (Worker& worker : _workers) {
+        if (worker.cues.empty()) continue;
+        worker.pending = true;
+        _busy++;
+    }
+    _wake.notify_all();
+
+    //-- Wait for the critical path.
+    _done.wait(lk, [this] { return _busy == 0; });
+
+    double remaining = (_start + _length) - _clock.now();
+    bool ok = _ok;
+    _length = 0.0;
+    lk.unlock();
+
+    if (remaining > 0.0) {
+        _clock.delay(remaining);
+    }
+
+    return ok;
+}
+
+
+void Choreographer::run(std::size_t track, std::function<void()> on_start) {
+
+    Worker& worker = _workers[track];
+
+    if (on_start) on_start();
+
+    while (true) {
+
+        //-- Wait for something to play.
+        std::vector<Cue> cues;
+        double start;
+        {
+            std::unique_lock<std::mutex> lk(_lock);
+            _wake.wait(lk, [this, &worker] { return _stopping || worker.pending; });
+            if (_stopping) return;
+
+            cues.swap(worker.cues);
+            start = _start;
+        }
+
+        std::stable_sort(cues.begin(), cues.end(),
+            [](const Cue& a, const Cue& b) { return a.at < b.at; });
+
+        //-- Run each cue at its time from the shared start.
+        bool ok = true;
+        for (const Cue& cue : cues) {
+            _clock.delayUntil(start + cue.at);
+            ok &= cue.action();
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(_lock);
+            worker.pending = false;
+            _ok &= ok;
+            _busy--;
+        }
+        _done.notify_all();
+    }
+}
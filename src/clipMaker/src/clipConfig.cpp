@@ -0,0 +1,240 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <clipConfig.hpp>
+
+
+bool ClipConfig::load(yarp::os::Searchable& conf, const std::size_t num_joints, const bool strict, std::string& error) {
+
+    //-- Init the body vars.
+    bool ok = true;
+    yarp::os::Bottle* la_home = conf.find("left_arm_home").asList();
+    yarp::os::Bottle* ra_home = conf.find("right_arm_home").asList();
+    yarp::os::Bottle* la_rp   = conf.find("body_left_arm_right_peg").asList();
+    yarp::os::Bottle* la_mp   = conf.find("body_left_arm_mid_peg").asList();
+    yarp::os::Bottle* ra_mp   = conf.find("body_right_arm_mid_peg").asList();
+    yarp::os::Bottle* ra_lp   = conf.find("body_right_arm_left_peg").asList();
+
+    ok &= loadBottleAsVec(la_home, left_arm_home);
+    ok &= loadBottleAsVec(ra_home, right_arm_home);
+    ok &= loadBottleAsVec(la_rp,   left_arm_right_peg);
+    ok &= loadBottleAsVec(la_mp,   left_arm_mid_peg);
+    ok &= loadBottleAsVec(ra_mp,   right_arm_mid_peg);
+    ok &= loadBottleAsVec(ra_lp,   right_arm_left_peg);
+    if (!ok) {
+        error = "missing joint positions";
+        if (strict) return false;
+    }
+
+    body_speed        = conf.check("body_speed",        yarp::os::Value(30.0), "body speed (double)").asFloat64();
+    body_home_timeout = conf.check("body_home_timeout", yarp::os::Value(10.0), "body home timeout (double)").asFloat64();
+
+
+    //-- Optionally stream minimum-jerk trajectories instead of positionMove.
+    body_mode        = conf.check("body_mode",        yarp::os::Value("position"), "body mode {position|minjerk} (string)").asString();
+    body_traj_time   = conf.check("body_traj_time",   yarp::os::Value(1.5),   "body trajectory time (double)").asFloat64();
+    body_stream_rate = conf.check("body_stream_rate", yarp::os::Value(100.0), "body stream rate hz (double)").asFloat64();
+    body_hold        = conf.check("body_hold",        yarp::os::Value(1.5),   "body hold time (double)").asFloat64();
+    body_stagger     = conf.check("body_stagger",     yarp::os::Value(0.4),   "body arm offset (double)").asFloat64();
+    body_gaze        = conf.check("body_gaze",        yarp::os::Value(false), "gaze follows arms (bool)").asBool();
+
+    body_start_tolerance = conf.check("body_start_tolerance", yarp::os::Value(5.0), "body start tolerance deg (double)").asFloat64();
+
+    //-- Trajectories are sampled at 1 / body_stream_rate for body_traj_time.
+    if (body_stream_rate <= 0.0) {
+        error = "body_stream_rate must be positive";
+        return false;
+    }
+    if (body_traj_time <= 0.0) {
+        error = "body_traj_time must be positive";
+        return false;
+    }
+
+    //-- Streaming sends and checks num_joints values a row, which the samples must hold.
+    if (body_mode == "minjerk") {
+        for (const std::vector<double>* pose : { &left_arm_home, &right_arm_home, &left_arm_right_peg, 
+                                                 &left_arm_mid_peg, &right_arm_mid_peg, &right_arm_left_peg }) {
+            if (pose->size() != num_joints) {
+                error = "minjerk needs every pose to have num_joints (" + std::to_string(num_joints) + ") positions";
+                return false;
+            }
+        }
+    }
+
+
+    //-- Init the expression vars.
+    expr_timer = conf.check("expr_timer", yarp::os::Value(0.2), "expressions (double)").asFloat64();
+
+
+    //-- Set trajectory times.
+    gaze_speed = conf.check("gaze_speed", yarp::os::Value(1.0), "gaze speed (double)").asFloat64();
+
+
+    //-- Load variables for gaze positions
+    gaze_home.push_back(conf.check("gaze_home_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_home.push_back(conf.check("gaze_home_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_home.push_back(conf.check("gaze_home_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+
+    gaze_left.push_back(conf.check("gaze_left_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_left.push_back(conf.check("gaze_left_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_left.push_back(conf.check("gaze_left_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+
+    gaze_mid.push_back(conf.check("gaze_mid_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_mid.push_back(conf.check("gaze_mid_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_mid.push_back(conf.check("gaze_mid_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+
+    gaze_right.push_back(conf.check("gaze_right_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_right.push_back(conf.check("gaze_right_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    gaze_right.push_back(conf.check("gaze_right_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+
+
+    //-- Init the speech vars.
+    spch_timer = conf.check("spch_timer", yarp::os::Value(3.0), "speech duration (double)").asFloat64();
+
+    yarp::os::Bottle* pattern = conf.find("spch_pattern").asList();
+    if (!loadBottleAsVec(pattern, spch_pattern) || spch_pattern.empty()) {
+        spch_pattern = { 0.2, 0.2 };
+    }
+    for (double& duration : spch_pattern) {
+        duration = std::max(duration, 0.01);
+    }
+
+    //-- Steps alternate open and closed, so an odd pattern would swap them every cycle.
+    if (spch_pattern.size() % 2 != 0) {
+        error = "spch_pattern needs (open closed) pairs of durations";
+        return false;
+    }
+
+    return true;
+}
+
+
+void ClipConfig::build() {
+
+    //-- Each arm only ever goes between home and one of its pegs.
+    trajectories.clear();
+    if (body_mode == "minjerk") {
+        for (const std::vector<double>* peg : { &left_arm_right_peg, &left_arm_mid_peg }) {
+            addTrajectory(left_arm_home, *peg);
+            addTrajectory(*peg, left_arm_home);
+        }
+        for (const std::vector<double>* peg : { &right_arm_mid_peg, &right_arm_left_peg }) {
+            addTrajectory(right_arm_home, *peg);
+            addTrajectory(*peg, right_arm_home);
+        }
+    }
+
+    face_frames.clear();
+
+    face_frames["neutral"]      = makeFaceFrame({ "set all neu" });
+    face_frames["happy"]        = makeFaceFrame({ "set all hap" });
+    face_frames["shy"]          = makeFaceFrame({ "set all shy" });
+
+    //-- Eyebrow changes also reset the mouth, it can do strange things...
+    face_frames["reb_up"]       = makeFaceFrame({ "set reb sur", "set mou neu" });
+    face_frames["reb_down"]     = makeFaceFrame({ "set reb neu", "set mou neu" });
+    face_frames["leb_up"]       = makeFaceFrame({ "set leb sur", "set mou neu" });
+    face_frames["leb_down"]     = makeFaceFrame({ "set leb neu", "set mou neu" });
+
+    face_frames["mouth_open"]   = makeFaceFrame({ "set mou surp" });
+    face_frames["mouth_closed"] = makeFaceFrame({ "set mou neu" });
+
+    return;
+}
+
+
+void ClipConfig::bodyPoses(const int from, const int to, const std::vector<double>*& r_arm, const std::vector<double>*& l_arm) const {
+
+    bool left_used  = (from == 0 || to == 0);
+    bool right_used = (from == 2 || to == 2);
+
+    int right_arm_peg, left_arm_peg;
+
+    if (left_used) {
+
+        //-- Right arm will point to left peg (0)
+        right_arm_peg = 0;
+
+        //-- If the right peg (2) was used, left arm points to right peg.
+        left_arm_peg = (right_used ? 2 : 1);
+
+    } else {
+
+        //-- If the left (0) is not used we have...
+        right_arm_peg = 1;
+        left_arm_peg  = 2;
+
+    }
+
+    r_arm = ( right_arm_peg == 1 ? &right_arm_mid_peg : &right_arm_left_peg );
+    l_arm = ( left_arm_peg  == 1 ? &left_arm_mid_peg  : &left_arm_right_peg );
+
+    return;
+}
+
+
+const std::vector<double>* ClipConfig::gazeTarget(const int peg) const {
+    if (peg == 0) return &gaze_left;
+    if (peg == 1) return &gaze_mid;
+    if (peg == 2) return &gaze_right;
+    return &gaze_home;
+}
+
+
+const Trajectory& ClipConfig::trajectory(const std::vector<double>& from, const std::vector<double>& to) const {
+    return trajectories.at(std::make_pair(&from, &to));
+}
+
+
+void ClipConfig::addTrajectory(const std::vector<double>& from, const std::vector<double>& to) {
+    trajectories.emplace(std::make_pair(&from, &to), Trajectory(from, to, body_traj_time, 1.0 / body_stream_rate));
+    return;
+}
+
+
+FaceFrame ClipConfig::makeFaceFrame(const std::vector<std::string> msgs) {
+
+    FaceFrame frame;
+    for (const std::string& msg : msgs) {
+
+        //-- Make a bottle.
+        yarp::os::Bottle bot; bot.clear();
+
+        //-- Parse this string up into individual words.
+        std::istringstream ss(msg);
+
+        //-- Add each word to the bottle.
+        std::string word;
+        while (ss >> word)
+            bot.addString(word);
+
+        frame.push_back(bot);
+    }
+
+    return frame;
+}
+
+
+bool ClipConfig::loadBottleAsVec(yarp::os::Bottle* bot, std::vector<double>& vec) {
+
+    //-- If bottle couldn't be loaded, return false.
+    if (bot == NULL) { return false; }
+
+    //-- Clear out the vector and push the vectors contents into it.
+    vec.clear();
+    for (int idx = 0; idx < bot->size(); ++idx) {
+        vec.push_back(bot->get(idx).asFloat64());
+    }
+
+    //-- Return success.
+    return true;
+}
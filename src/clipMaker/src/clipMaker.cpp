@@ -13,6 +13,12 @@
 #include <clipMaker.hpp>
 
 
+void ClipMaker::setCommandLine(int argc, char** argv) {
+    _command_line.fromCommand(argc, argv, true, true);
+    return;
+}
+
+
 bool ClipMaker::configure(yarp::os::ResourceFinder &rf) {
 
     //-- Get some variables from the configuration file that the resource finder loaded.
@@ -27,126 +33,111 @@ bool ClipMaker::configure(yarp::os::ResourceFinder &rf) {
     }
     this->attach(_rpc);
 
-    bool ok = true;
-    ok &= _expr_port.open(this->getName() + "/expr:o");
-    if (!ok) {
-        yInfo("%s: Unable to open control ports!!", this->getName().c_str());
-        return false;
-    }
-
     _robot_name = rf.check("robot", yarp::os::Value("icubSim"), "robot name (string)").asString();
 
 
-    //-- Init the body vars.
-    yarp::os::Bottle* la_home = rf.find("left_arm_home").asList();
-    yarp::os::Bottle* ra_home = rf.find("right_arm_home").asList();
-    yarp::os::Bottle* la_rp   = rf.find("body_left_arm_right_peg").asList();
-    yarp::os::Bottle* la_mp   = rf.find("body_left_arm_mid_peg").asList();
-    yarp::os::Bottle* ra_mp   = rf.find("body_right_arm_mid_peg").asList();
-    yarp::os::Bottle* ra_lp   = rf.find("body_right_arm_left_peg").asList();
-
-    ok &= loadBottleAsVec(la_home, _left_arm_home);
-    ok &= loadBottleAsVec(ra_home, _right_arm_home);
-    ok &= loadBottleAsVec(la_rp,   _left_arm_right_peg);
-    ok &= loadBottleAsVec(la_mp,   _left_arm_mid_peg);
-    ok &= loadBottleAsVec(ra_mp,   _right_arm_mid_peg);
-    ok &= loadBottleAsVec(ra_lp,   _right_arm_left_peg);
-    if (!ok) {
-        yInfo("%s: Unable to joint positions!!", this->getName().c_str());
-    }
-
-
-    //-- Prepare the joint interfaces.
-    yarp::os::Property opt_left_arm;
-    opt_left_arm.put("device","remote_controlboard");
-    opt_left_arm.put("remote","/"+_robot_name+"/left_arm");
-    opt_left_arm.put("local","/"+this->getName()+"/left_arm");
-    if (!_left_arm.open(opt_left_arm)) {
-        yInfo("%s: Unable to open %s left arm!!", _robot_name.c_str(), this->getName().c_str());
-        return false;
-    }
+    //-- Pick the clock and robot backend. The fake backend records every
+    //-- command instead of moving anything, optionally faster than real time.
+    _num_joints  = rf.check("num_joints",  yarp::os::Value(16),     "num joints (int)").asInt32();
+    _backend     = rf.check("backend",     yarp::os::Value("yarp"), "robot backend {yarp|fake} (string)").asString();
+    _gaze_remote = rf.check("gaze_remote", yarp::os::Value("/iKinGazeCtrl"), "gaze controller (string)").asString();
 
-    yarp::os::Property opt_right_arm;
-    opt_right_arm.put("device","remote_controlboard");
-    opt_right_arm.put("remote","/"+_robot_name+"/right_arm");
-    opt_right_arm.put("local","/"+this->getName()+"/right_arm");
-    if (!_right_arm.open(opt_right_arm)) {
-        yInfo("%s: Unable to open %s right arm!!", _robot_name.c_str(), this->getName().c_str());
+    if (_backend == "fake") {
+        double warp = rf.check("time_warp", yarp::os::Value(1.0), "time warp factor (double)").asFloat64();
+        _clock.reset(new VirtualClock(warp));
+    } else if (_backend == "yarp") {
+        _clock.reset(new SystemClock());
+    } else {
+        yInfo("%s: Unknown backend ``%s``!!", this->getName().c_str(), _backend.c_str());
         return false;
     }
 
-
-    //-- Attach the position controllers.
-    ok &= _left_arm.view(_left_arm_pos);
-    ok &= _right_arm.view(_right_arm_pos);
-    if (!ok) {
-        yInfo("%s: Unable to open position interfaces!!", this->getName().c_str());
+    //-- Optionally run behaviors with real-time scheduling. Anything that
+    //-- isn't permitted is warned about and skipped.
+    //-- Settings out of range are refused, not warned about.
+    _rt.enabled        = rf.check("rt_enabled",        yarp::os::Value(false), "real-time behaviors (bool)").asBool();
+    _rt.priority       = rf.check("rt_priority",       yarp::os::Value(80),    "SCHED_FIFO priority (int)").asInt32();
+    _rt.lock_memory    = rf.check("rt_lock_memory",    yarp::os::Value(true),  "mlockall (bool)").asBool();
+
+    int prefault_stack = rf.check("rt_prefault_stack", yarp::os::Value(512 * 1024),       "stack bytes per thread (int)").asInt32();
+    int prefault_heap  = rf.check("rt_prefault_heap",  yarp::os::Value(64 * 1024 * 1024), "heap bytes (int)").asInt32();
+    if (prefault_stack < 0 || prefault_heap < 0) {
+        yError("%s: rt_prefault_stack and rt_prefault_heap can't be negative!!", this->getName().c_str());
         return false;
     }
+    _rt.prefault_stack = prefault_stack;
+    _rt.prefault_heap  = prefault_heap;
 
-
-    //-- Set the speed for all joints.
-    _num_joints = rf.check("num_joints", yarp::os::Value(16),   "num joints (int)").asInt32();
-    _body_speed = rf.check("body_speed", yarp::os::Value(30.0), "body speed (double)").asFloat64();
-    for (int joint = 0; joint < _num_joints; ++joint) {
-        _left_arm_pos->setRefSpeed(joint, _body_speed);
-        _right_arm_pos->setRefSpeed(joint, _body_speed);
+    yarp::os::Bottle* rt_cpus = rf.find("rt_cpus").asList();
+    for (int idx = 0; rt_cpus && idx < rt_cpus->size(); ++idx) {
+        _rt.cpus.push_back(rt_cpus->get(idx).asInt32());
     }
 
-
-    //-- Init the expression vars.
-    _expr_timer = rf.check("expr_timer", yarp::os::Value(0.2), "expressions (double)").asFloat64();
-
-
-    //-- Init the gaze vars.
-    yarp::os::Property opt_gaze;
-    opt_gaze.put("device","gazecontrollerclient");
-    opt_gaze.put("remote","/iKinGazeCtrl");
-    opt_gaze.put("local","/"+this->getName()+"/gaze");
-    if (!_gaze_client.open(opt_gaze)) {
-        yInfo("%s: Unable to open %s gaze control client!!", _robot_name.c_str(), this->getName().c_str());
+    std::string rt_error;
+    if (!Realtime::check(_rt, rt_error)) {
+        yError("%s: %s!!", this->getName().c_str(), rt_error.c_str());
         return false;
     }
 
+    if (_rt.enabled && !Realtime::setupProcess(_rt)) {
+        yWarning("%s: Real-time process setup incomplete, see above!!", this->getName().c_str());
+    }
+
+    //-- Every command sent is stamped into a preallocated log per instance,
+    //-- flushed after each behavior. Publishing needs a yarp network.
+    _event_capacity = rf.check("event_capacity", yarp::os::Value(4096), "events per behavior (int)").asInt32();
+    _events_port    = rf.check("events_port", yarp::os::Value(_backend == "yarp"), "publish events (bool)").asBool();
 
-    //-- Attach the gaze controller.
-    ok &= _gaze_client.view(_gaze);
-    if (!ok) {
-        yInfo("%s: Unable to open %s gaze control client!!", _robot_name.c_str(), this->getName().c_str());
+    //-- The default instance, plus any extra simulators for batch runs 
+    //-- listed as ``instances ((tag robot gaze_remote) ...)``.
+    if (!addInstance(_robot_name, _robot_name, _gaze_remote)) {
         return false;
     }
 
+    yarp::os::Bottle* extra = rf.find("instances").asList();
+    for (int idx = 0; extra && idx < extra->size(); ++idx) {
 
-    //-- Set up a restoration point.
-    _gaze->storeContext(&_gaze_startup_context);
+        yarp::os::Bottle* inst = extra->get(idx).asList();
+        if (inst == NULL || inst->size() != 3) {
+            yInfo("%s: Instances must be given as (tag robot gaze_remote)!!", this->getName().c_str());
+            return false;
+        }
 
+        if (!addInstance(inst->get(0).asString(), inst->get(1).asString(), inst->get(2).asString())) {
+            return false;
+        }
+    }
 
-    //-- Set trajectory times.
-    _gaze_speed = rf.check("gaze_speed", yarp::os::Value(1.0), "gaze speed (double)").asFloat64();
-    _gaze->setNeckTrajTime(_gaze_speed);
-    _gaze->setEyesTrajTime(0.8);
 
+    //-- Load the behavior vars, and optionally reload them when the file changes.
+    if (!loadConfig(rf, false)) {
+        return false;
+    }
 
-    //-- Load variables for gaze positions
-    _gaze_home.push_back(rf.check("gaze_home_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_home.push_back(rf.check("gaze_home_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_home.push_back(rf.check("gaze_home_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    _config_file  = rf.findFile("from");
+    _config_watch = rf.check("config_watch", yarp::os::Value(false), "reload on config change (bool)").asBool();
+    _config_mtime = 0;
 
-    _gaze_left.push_back(rf.check("gaze_left_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_left.push_back(rf.check("gaze_left_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_left.push_back(rf.check("gaze_left_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    struct stat st;
+    if (!_config_file.empty() && stat(_config_file.c_str(), &st) == 0) {
+        _config_mtime = st.st_mtime;
+    }
 
-    _gaze_mid.push_back(rf.check("gaze_mid_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_mid.push_back(rf.check("gaze_mid_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_mid.push_back(rf.check("gaze_mid_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
+    //-- Set the speeds on every instance up front.
+    for (auto& inst : _instances) {
+        applyConfig(*inst, config());
+    }
 
-    _gaze_right.push_back(rf.check("gaze_right_x", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_right.push_back(rf.check("gaze_right_y", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
-    _gaze_right.push_back(rf.check("gaze_right_z", yarp::os::Value(0.0), "gaze vars (double)").asFloat64());
 
+    //-- Load the manifest of clips that have already been generated.
+    _clip_path = rf.check("clip_path", yarp::os::Value("."), "clip library path (string)").asString();
+    if (!_manifest.openManifest(_clip_path + "/manifest.txt")) {
+        yInfo("%s: Unable to read clip manifest in %s!!", this->getName().c_str(), _clip_path.c_str());
+        return false;
+    }
 
-    //-- Init the speech vars.
-    _spch_timer = rf.check("spch_timer", yarp::os::Value(3.0), "speech duration (double)").asFloat64();
+    //-- Timelines of the fake backend go next to the clips by default.
+    _timeline_path = rf.check("timeline_path", yarp::os::Value(_clip_path), "timeline path (string)").asString();
 
     return true;
 }
@@ -156,10 +147,11 @@ bool ClipMaker::interruptModule() {
     
     //-- Interrupt the ports.
     _rpc.interrupt();
-    _expr_port.interrupt();
 
-    _gaze->stopControl();
-    _gaze->restoreContext(_gaze_startup_context);
+    for (auto& inst : _instances) {
+        inst->events_port.interrupt();
+        inst->robot->interrupt();
+    }
 
     return true;
 }
@@ -169,12 +161,12 @@ bool ClipMaker::close() {
 
     //-- Close the yarp ports.
     _rpc.close();
-    _expr_port.close();
 
-    _left_arm.close();
-    _right_arm.close();
-
-    _gaze_client.close();
+    for (auto& inst : _instances) {
+        inst->executor.reset();
+        inst->events_port.close();
+        inst->robot->close();
+    }
 
     return true;
 }
@@ -182,7 +174,7 @@ bool ClipMaker::close() {
 
 bool ClipMaker::respond(const yarp::os::Bottle &cmd, yarp::os::Bottle &reply) {
     
-    std::string helpMessage = std::string(getName().c_str()) + " commands are: home | beh {blob|body|spch|gaze|expr} <int> <int> | help | quit";
+    std::string helpMessage = std::string(getName().c_str()) + " commands are: home | beh {blob|body|spch|gaze|expr} <int> <int> | batch [force] | reload [<file>] | rtbench [<iterations> <period>] | help | quit";
     reply.clear();
 
     std::string command = cmd.get(0).asString();
@@ -193,7 +185,8 @@ bool ClipMaker::respond(const yarp::os::Bottle &cmd, yarp::os::Bottle &reply) {
         reply.addString(helpMessage);
     } else if (command == "home") {
 
-        bool result = runHome();
+        Instance& inst = *_instances[0];
+        bool result = inst.executor->run([this, &inst] { return runHome(inst); });
         reply.addString((result ? "ack" : "err"));
 
     } else if (command == "beh") {
@@ -211,9 +204,55 @@ bool ClipMaker::respond(const yarp::os::Bottle &cmd, yarp::os::Bottle &reply) {
         int from = cmd.get(2).asInt32();
         int to   = cmd.get(3).asInt32(); // if not an int, will return 0;
 
-        bool result = runBehavior(behavior, from, to);
+        Instance& inst = *_instances[0];
+        bool result = inst.executor->run([this, &inst, behavior, from, to] { 
+            return runBehavior(inst, config(), behavior, from, to); 
+        });
+        reply.addString((result ? "ack" : "err"));
+
+        //-- Report how well periodic loops kept to their deadlines.
+        if (_instances[0]->jitter.count() > 0) {
+            _instances[0]->jitter.addTo(reply, "jitter");
+        }
+
+    } else if (command == "batch") {
+
+        //-- Regenerate only the clips whose config changed, unless forced.
+        bool force = (cmd.get(1).asString() == "force");
+
+        yarp::os::Bottle regenerated;
+        bool result = runBatch(force, regenerated);
+        reply.addString((result ? "ack" : "err"));
+        reply.addList() = regenerated;
+
+    } else if (command == "reload") {
+
+        //-- Swapped in for the next behavior; nothing is reopened.
+        std::string fname = (cmd.size() > 1 ? cmd.get(1).asString() : _config_file);
+        bool result = reloadConfig(fname);
         reply.addString((result ? "ack" : "err"));
 
+    } else if (command == "rtbench") {
+
+        int    iterations = (cmd.size() > 1 ? cmd.get(1).asInt32()   : 1000);
+        double period     = (cmd.size() > 2 ? cmd.get(2).asFloat64() : 0.01);
+        if (iterations <= 0 || period <= 0.0) {
+            reply.addString("[error] Iterations and period must be positive. Example: ``rtbench 1000 0.01``");
+            return true;
+        }
+
+        //-- Both loops run on the rpc thread, which can't answer anything else meanwhile.
+        if (iterations * period > RTBENCH_MAX_TIME) {
+            reply.addString("[error] Iterations times period must be at most " 
+                + std::to_string(static_cast<int>(RTBENCH_MAX_TIME)) + " seconds. Example: ``rtbench 1000 0.01``");
+            return true;
+        }
+
+        yarp::os::Bottle results;
+        bool result = rtBenchmark(iterations, period, results);
+        reply.addString((result ? "ack" : "err"));
+        reply.append(results);
+
     // TODO: <REMOVE>
     } else if (command == "gz") {
 
@@ -222,19 +261,26 @@ bool ClipMaker::respond(const yarp::os::Bottle &cmd, yarp::os::Bottle &reply) {
         double y = cmd.get(3).asFloat64();
         double z = cmd.get(4).asFloat64();
 
+        //-- Edit a copy of the current config and swap it in.
+        std::lock_guard<std::mutex> lg(_reload_lock);
+        std::shared_ptr<ClipConfig> cfg(new ClipConfig(*config()));
+
         if (which_peg == "left") {
-            _gaze_left[0] = x;
-            _gaze_left[1] = y;
-            _gaze_left[2] = z;
+            cfg->gaze_left[0] = x;
+            cfg->gaze_left[1] = y;
+            cfg->gaze_left[2] = z;
         } else if (which_peg == "mid") {
-            _gaze_mid[0] = x;
-            _gaze_mid[1] = y;
-            _gaze_mid[2] = z;
+            cfg->gaze_mid[0] = x;
+            cfg->gaze_mid[1] = y;
+            cfg->gaze_mid[2] = z;
         } else if (which_peg == "right") {
-            _gaze_right[0] = x;
-            _gaze_right[1] = y;
-            _gaze_right[2] = z;
+            cfg->gaze_right[0] = x;
+            cfg->gaze_right[1] = y;
+            cfg->gaze_right[2] = z;
         }
+
+        cfg->build();
+        std::atomic_store(&_config, std::shared_ptr<const ClipConfig>(cfg));
         
 
         reply.addString("ack");
@@ -256,289 +302,709 @@ double ClipMaker::getPeriod() {
 
 
 bool ClipMaker::updateModule() {
+
+    //-- Pick up edits to the config file.
+    struct stat st;
+    if (_config_watch && stat(_config_file.c_str(), &st) == 0 && st.st_mtime != _config_mtime) {
+        _config_mtime = st.st_mtime;
+        yInfo("%s: Config %s changed, reloading", this->getName().c_str(), _config_file.c_str());
+        reloadConfig(_config_file);
+    }
+
     return true;
 }
 
 
-bool ClipMaker::runHome() {
+std::shared_ptr<const ClipConfig> ClipMaker::config() {
+    return std::atomic_load(&_config);
+}
+
+
+bool ClipMaker::loadConfig(yarp::os::Searchable& conf, const bool strict) {
+
+    std::lock_guard<std::mutex> lg(_reload_lock);
+
+    std::shared_ptr<ClipConfig> cfg(new ClipConfig());
+    std::string error;
+    if (!cfg->load(conf, _num_joints, strict, error)) {
+        yError("%s: Rejected the config, %s!!", this->getName().c_str(), error.c_str());
+        return false;
+    }
+    if (!error.empty()) {
+        yInfo("%s: Unable to load the config fully, %s!!", this->getName().c_str(), error.c_str());
+    }
+
+    for (auto& inst : _instances) {
+        if (cfg->body_mode == "minjerk" && !inst->robot->hasPositionDirect()) {
+            yWarning("%s: No position-direct control on %s, falling back to position mode!!", 
+                this->getName().c_str(), inst->tag.c_str());
+            cfg->body_mode = "position";
+        }
+    }
+
+    cfg->build();
+    std::atomic_store(&_config, std::shared_ptr<const ClipConfig>(cfg));
+
+    return true;
+}
+
+
+bool ClipMaker::reloadConfig(const std::string fname) {
+
+    yarp::os::Property conf;
+    if (fname.empty() || !conf.fromConfigFile(fname)) {
+        yInfo("%s: Unable to read config %s!!", this->getName().c_str(), fname.c_str());
+        return false;
+    }
+
+    //-- Options given at startup still win over the file, as they did then.
+    conf.fromString(_command_line.toString(), false);
+
+    return loadConfig(conf, true);
+}
+
+
+void ClipMaker::applyConfig(Instance& inst, const std::shared_ptr<const ClipConfig>& cfg) {
+
+    if (inst.applied == cfg) return;
+
+    inst.robot->setRefSpeed(cfg->body_speed);
+    inst.robot->setGazeTrajTime(cfg->gaze_speed, 0.8);
+    inst.applied = cfg;
+
+    return;
+}
+
+
+bool ClipMaker::addInstance(const std::string tag, const std::string robot_name, const std::string gaze_remote) {
+
+    std::unique_ptr<Instance> inst(new Instance());
+    inst->tag        = tag;
+    inst->fake_robot = nullptr;
+
+    //-- The first instance keeps the plain module name for its ports.
+    std::string local_name = this->getName();
+    if (!_instances.empty()) {
+        local_name += "/" + tag;
+    }
+
+    Robot* robot;
+    if (_backend == "fake") {
+        inst->fake_robot = new FakeRobot(*_clock, _num_joints);
+        robot = inst->fake_robot;
+    } else {
+        robot = new YarpRobot(local_name, robot_name, gaze_remote, _num_joints);
+    }
+
+    //-- Log every command on its way to the robot.
+    inst->events.reset(new EventLog(_event_capacity));
+    inst->robot.reset(new LoggedRobot(robot, *inst->events, *_clock, _num_joints));
+
+    std::string events_name = local_name + "/events:o";
+    if (_events_port && !inst->events_port.open(events_name)) {
+        yInfo("%s: Unable to open port %s", this->getName().c_str(), events_name.c_str());
+        return false;
+    }
+
+    if (!inst->robot->open()) {
+        yInfo("%s: Unable to open instance %s!!", this->getName().c_str(), tag.c_str());
+        return false;
+    }
+
+    //-- One worker per controller for behaviors that move several at once,
+    //-- driven from the instance's behavior thread.
+    inst->choreo.reset(new Choreographer(*_clock, [this] { setupThread(); }));
+    inst->executor.reset(new Executor([this] { setupThread(); }));
+
+    _instances.push_back(std::move(inst));
+
+    return true;
+}
+
+
+bool ClipMaker::runHome(Instance& inst) {
+
+    std::shared_ptr<const ClipConfig> cfg = config();
 
     //-- Ensure atomicity of communications.
-    std::lock_guard<std::mutex> lg(lock);
+    std::lock_guard<std::mutex> lg(inst.lock);
+    applyConfig(inst, cfg);
 
     //-- Set the body position to home.
-    _left_arm_pos->positionMove(_left_arm_home.data());
-    _right_arm_pos->positionMove(_right_arm_home.data());
+    inst.robot->positionMove(Limb::LeftArm,  cfg->left_arm_home.data());
+    inst.robot->positionMove(Limb::RightArm, cfg->right_arm_home.data());
     
     //-- Set gaze at home position.
-    //_gaze->restoreContext(_gaze_startup_context);
-    yarp::sig::Vector home_pos(_gaze_home.size(), _gaze_home.data());
-    _gaze->lookAtAbsAngles(home_pos);
+    yarp::sig::Vector home_pos(cfg->gaze_home.size(), cfg->gaze_home.data());
+    inst.robot->lookAtAbsAngles(home_pos);
 
     //-- Set to default expression.
-    sendMessage(_expr_port, "set all neu");
+    sendFrame(inst, *cfg, "neutral");
+
+    //-- Streamed moves start from home, so wait for the arms to get there.
+    //-- positionMove starts from wherever the arm is; position mode doesn't wait.
+    double deadline = _clock->now() + cfg->body_home_timeout;
+    bool left_done = false, right_done = false;
+    while (cfg->body_mode == "minjerk") {
+
+        if (!inst.robot->checkMotionDone(Limb::LeftArm,  left_done) ||
+            !inst.robot->checkMotionDone(Limb::RightArm, right_done)) {
+            yWarning("%s: Unable to check the arms got home!!", this->getName().c_str());
+            return false;
+        }
+
+        if (left_done && right_done) break;
+
+        if (_clock->now() >= deadline) {
+            yWarning("%s: Arms not home after %.1f seconds!!", this->getName().c_str(), cfg->body_home_timeout);
+            return false;
+        }
+
+        _clock->delay(0.05);
+    }
 
     return true;
 }
 
 
-bool ClipMaker::runBehavior(const std::string behavior, const int from, const int to) {
+bool ClipMaker::runBehavior(Instance& inst, const std::shared_ptr<const ClipConfig>& cfg, const std::string behavior, const int from, const int to) {
 
     //-- Don't even process if the same.
     if (from == to) return false;
 
+    //-- Start logging first, so the speeds a new config sets are in the logs.
+    inst.jitter.clear();
+    inst.events->start(_clock->now());
+
+    //-- Record a fresh timeline for this behavior on the fake backend.
+    if (inst.fake_robot) {
+        inst.fake_robot->startTimeline();
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(inst.lock);
+        applyConfig(inst, cfg);
+    }
+
     // blob|body|spch|gaze|expr
+    bool result = false;
     if (behavior == "blob") {
-        return true;
+        result = true;
     } else if (behavior == "body") {
-        return body(from, to);
+        result = body(inst, *cfg, from, to);
     } else if (behavior == "spch") {
-        return speech();
+        result = speech(inst, *cfg);
     } else if (behavior == "gaze") {
-        return gaze(from, to);
+        result = gaze(inst, *cfg, from, to);
     } else if (behavior == "expr") {
-        return expression(from, to);
+        result = expression(inst, *cfg, from, to);
+    }
+
+    if (inst.fake_robot && result) {
+        std::string fname = _timeline_path + "/" + behavior + "_" 
+            + std::to_string(from) + "_" + std::to_string(to) + ".timeline";
+        inst.fake_robot->writeTimeline(fname, inst.tag);
     }
 
-    return false;
+    if (result) {
+        flushEvents(inst, behavior, from, to);
+    }
+
+    return result;
 }
 
 
-bool ClipMaker::body(const int from, const int to) {
+void ClipMaker::flushEvents(Instance& inst, const std::string behavior, const int from, const int to) {
 
-    //-- Ensure atomicity of communications.
-    std::lock_guard<std::mutex> lg(lock);
+    if (inst.events->dropped() > 0) {
+        yWarning("%s: Dropped %zu events of ``%s %d %d``, raise event_capacity!!", 
+            this->getName().c_str(), inst.events->dropped(), behavior.c_str(), from, to);
+    }
 
-    bool left_used  = (from == 0 || to == 0);
-    bool mid_used   = (from == 1 || to == 1);
-    bool right_used = (from == 2 || to == 2);
+    //-- Sidecar next to the clip.
+    std::string fname = _clip_path + "/" + behavior + "_" 
+        + std::to_string(from) + "_" + std::to_string(to) + ".events";
+    inst.events->write(fname, inst.tag);
+
+    //-- And for anyone listening live.
+    if (_events_port) {
+        yarp::os::Bottle& bot = inst.events_port.prepare();
+        bot.clear();
+        inst.events->addTo(bot, ClipManifest::makeKey(behavior, from, to), inst.tag);
+        inst.events_port.write();
+    }
 
-    int right_arm_peg, left_arm_peg;
+    return;
+}
 
-    if (left_used) {
 
-        //-- Right arm will point to left peg (0)
-        right_arm_peg = 0;
+bool ClipMaker::runBatch(const bool force, yarp::os::Bottle& reply) {
 
-        //-- If the right peg (2) was used, left arm points to right peg.
-        left_arm_peg = (right_used ? 2 : 1);
+    const std::vector<std::string> behaviors = { "body", "spch", "gaze", "expr" };
+    const int num_pegs = 3;
 
-    } else {
+    //-- Collect the clips that are missing or were generated from different
+    //-- config values, dealing them out to the instances in turn.
+    std::shared_ptr<const ClipConfig> cfg = config();
 
-        //-- If the left (0) is not used we have...
-        right_arm_peg = 1;
-        left_arm_peg  = 2;
+    JobQueue queue(_instances.size());
+    std::size_t num_jobs = 0;
+    for (const std::string& behavior : behaviors) {
+        for (int from = 0; from < num_pegs; ++from) {
+            for (int to = 0; to < num_pegs; ++to) {
 
+                if (from == to) continue;
+
+                ClipJob job;
+                job.behavior = behavior;
+                job.from     = from;
+                job.to       = to;
+                job.key      = ClipManifest::makeKey(behavior, from, to);
+                job.hash     = ClipManifest::hash(behaviorSignature(*cfg, behavior, from, to));
+
+                std::lock_guard<std::mutex> lg(_manifest_lock);
+                if (!force && _manifest.isCurrent(job.key, job.hash)) {
+                    continue;
+                }
+
+                queue.push(num_jobs++ % _instances.size(), job);
+            }
+        }
     }
 
-    //-- Right arm goes first when f:0 t:1, f:0 t:2, and f:1 t:2
-    bool right_arm_first = (from < to);
+    //-- One worker per instance, on its behavior thread; idle workers steal
+    //-- from the busy ones.
+    std::vector<std::vector<std::string>> done(_instances.size());
+    std::vector<std::future<bool>> workers;
+    for (std::size_t idx = 0; idx < _instances.size(); ++idx) {
+        workers.push_back(_instances[idx]->executor->submit([this, idx, &queue, &done] {
+            return batchWorker(idx, queue, done[idx]);
+        }));
+    }
 
-    double* r_arm_pos = ( right_arm_peg == 1 ? _right_arm_mid_peg.data() : _right_arm_left_peg.data() );
-    double* l_arm_pos = ( left_arm_peg  == 1 ? _left_arm_mid_peg.data()  : _left_arm_right_peg.data() );
+    bool ok = true;
+    for (std::size_t idx = 0; idx < workers.size(); ++idx) {
+        ok &= workers[idx].get();
+        for (const std::string& entry : done[idx]) {
+            reply.addString(entry);
+        }
+    }
 
-    //-- If the right arm goes first, do it.
-    if (right_arm_first) {
+    return ok;
+}
 
-        _right_arm_pos->positionMove(r_arm_pos);
-        yarp::os::Time::delay(0.4);
-        _left_arm_pos->positionMove(l_arm_pos);
-        yarp::os::Time::delay(3.0);
-        _left_arm_pos->positionMove(_left_arm_home.data());
-        yarp::os::Time::delay(0.4);
-        _right_arm_pos->positionMove(_right_arm_home.data());
-        yarp::os::Time::delay(3.0);
-        
-    } else {
 
-        _left_arm_pos->positionMove(l_arm_pos);
-        yarp::os::Time::delay(0.4);
-        _right_arm_pos->positionMove(r_arm_pos);
-        yarp::os::Time::delay(3.0);
-        _right_arm_pos->positionMove(_right_arm_home.data());
-        yarp::os::Time::delay(0.4);
-        _left_arm_pos->positionMove(_left_arm_home.data());
-        yarp::os::Time::delay(3.0);
+bool ClipMaker::batchWorker(std::size_t idx, JobQueue& queue, std::vector<std::string>& done) {
+
+    Instance& inst = *_instances[idx];
+
+    bool ok = true;
+    std::string last_behavior;
+
+    ClipJob job;
+    while (queue.pop(idx, job)) {
+
+        //-- Start each behavior from home, as the run scripts do.
+        if (job.behavior != last_behavior) {
+            if (!runHome(inst)) {
+                yWarning("%s: Unable to home %s, skipping ``%s``!!", this->getName().c_str(), inst.tag.c_str(), job.key.c_str());
+                ok = false;
+                continue;
+            }
+            last_behavior = job.behavior;
+        }
+
+        //-- Record the hash of the config the clip is actually made with, 
+        //-- in case it was reloaded since the batch started.
+        std::shared_ptr<const ClipConfig> cfg = config();
+        job.hash = ClipManifest::hash(behaviorSignature(*cfg, job.behavior, job.from, job.to));
+
+        yInfo("%s: Generating ``%s`` on %s", this->getName().c_str(), job.key.c_str(), inst.tag.c_str());
+        if (!runBehavior(inst, cfg, job.behavior, job.from, job.to)) {
+            ok = false;
+            continue;
+        }
 
+        //-- Save after every clip so an interrupted batch can resume.
+        {
+            std::lock_guard<std::mutex> lg(_manifest_lock);
+            _manifest.update(job.key, job.hash, inst.tag);
+            _manifest.saveManifest();
+        }
+        done.push_back(job.key + " " + inst.tag);
     }
 
-    return true;
+    if (!last_behavior.empty() && !runHome(inst)) {
+        yWarning("%s: Unable to home %s after the batch!!", this->getName().c_str(), inst.tag.c_str());
+        ok = false;
+    }
+
+    return ok;
 }
 
 
-bool ClipMaker::expression(const int from, const int to) {
+bool ClipMaker::rtBenchmark(const int iterations, const double period, yarp::os::Bottle& reply) {
 
-    //-- Ensure atomicity of communications.
-    std::lock_guard<std::mutex> lg(lock);
+    //-- Always measured against the wall clock, whatever the backend.
+    SystemClock clock;
 
+    auto measure = [&clock, iterations, period](JitterStats& stats) {
+        double deadline = clock.now();
+        for (int idx = 0; idx < iterations; ++idx) {
+            deadline += period;
+            clock.delayUntil(deadline);
+            stats.add(clock.now() - deadline);
+        }
+    };
 
-    //-- Ensure we're starting at neutral.
-    sendMessage(_expr_port, "set all neu");
+    //-- Plain thread, default scheduling.
+    JitterStats normal;
+    std::thread(measure, std::ref(normal)).join();
 
-    //-- Wait a short while before beginning.
-    yarp::os::Time::delay(1.0);
+    //-- Same loop with the real-time settings, whether or not they're
+    //-- enabled for behaviors.
+    RealtimeConfig rt = _rt;
+    rt.enabled = true;
 
-    //-- Move the right eyebrow up and down equal to idx for from.
-    for (int i = 0; i < (from+1); ++i) {
+    JitterStats realtime;
+    bool applied = false;
+    std::thread([&] {
+        applied = Realtime::setupThread(rt);
+        measure(realtime);
+    }).join();
 
-        //-- Eyebrow up.
-        sendMessage(_expr_port, "set reb sur");
-        sendMessage(_expr_port, "set mou neu"); // mouth can do strange things...
+    normal.addTo(reply, "normal");
+    realtime.addTo(reply, "realtime");
 
-        //-- Wait.
-        yarp::os::Time::delay(_expr_timer);
+    yarp::os::Bottle& status = reply.addList();
+    status.addString("rt_applied");
+    status.addString(applied ? "true" : "false");
 
-        //-- Eyebrow down.
-        sendMessage(_expr_port, "set reb neu");
-        sendMessage(_expr_port, "set mou neu");
+    return true;
+}
 
-        //-- Wait.
-        yarp::os::Time::delay(_expr_timer);
 
-    } // repeat.
-    
-    //-- Wait a little bit between hints.
-    yarp::os::Time::delay((1.0 - _expr_timer));
+void ClipMaker::setupThread() {
+    if (_rt.enabled) {
+        Realtime::setupThread(_rt);
+    }
+    return;
+}
 
-    //-- Move the left eyebrow up and down equal to idx for to.
-    for (int i = 0; i < (to+1); ++i) {
 
-        //-- Eyebrow up.
-        sendMessage(_expr_port, "set leb sur");
-        sendMessage(_expr_port, "set mou neu"); 
+std::string ClipMaker::behaviorSignature(const ClipConfig& cfg, const std::string behavior, const int from, const int to) {
+
+    std::ostringstream ss;
+    ss << std::setprecision(10);
+
+    auto append = [&ss](const std::string name, const std::vector<double>& vec) {
+        ss << name << " (";
+        for (double val : vec) ss << " " << val;
+        ss << " ) ";
+    };
+
+    //-- The trailing number is a version for the behavior itself; 
+    //-- bump it when the behavior code changes.
+    ss << behavior << " " << from << " " << to << " ";
+    if (behavior == "body") {
+
+        const std::vector<double>* r_arm_pos;
+        const std::vector<double>* l_arm_pos;
+        cfg.bodyPoses(from, to, r_arm_pos, l_arm_pos);
+
+        ss << "v1 ";
+        append("left_arm_home",  cfg.left_arm_home);
+        append("right_arm_home", cfg.right_arm_home);
+        append("right_arm_peg",  *r_arm_pos);
+        append("left_arm_peg",   *l_arm_pos);
+        ss << "num_joints " << _num_joints << " body_speed " << cfg.body_speed;
+        ss << " body_mode " << cfg.body_mode << " body_stagger " << cfg.body_stagger << " body_gaze " << cfg.body_gaze;
+        if (cfg.body_gaze) {
+            append("gaze_home", cfg.gaze_home);
+            append("gaze_from", *cfg.gazeTarget(from));
+            append("gaze_to",   *cfg.gazeTarget(to));
+        }
+        if (cfg.body_mode == "minjerk") {
+            ss << " body_traj_time " << cfg.body_traj_time << " body_stream_rate " << cfg.body_stream_rate
+               << " body_hold " << cfg.body_hold;
+        }
 
-        //-- Wait.
-        yarp::os::Time::delay(_expr_timer);
+    } else if (behavior == "gaze") {
 
-        //-- Eyebrow down.
-        sendMessage(_expr_port, "set leb neu");
-        sendMessage(_expr_port, "set mou neu");
+        ss << "v1 ";
+        append("gaze_home", cfg.gaze_home);
+        append("gaze_from", *cfg.gazeTarget(from));
+        append("gaze_to",   *cfg.gazeTarget(to));
+        ss << "gaze_speed " << cfg.gaze_speed;
 
-        //-- Wait.
-        yarp::os::Time::delay(_expr_timer);
+    } else if (behavior == "expr") {
+        ss << "v1 expr_timer " << cfg.expr_timer;
+    } else if (behavior == "spch") {
+        ss << "v2 spch_timer " << cfg.spch_timer;
+        append(" spch_pattern", cfg.spch_pattern);
+    }
 
-    } // repeat.
+    return ss.str();
+}
 
-    //-- Wait a bit of time then show "correct" and "incorrect" guess gestures.
-    yarp::os::Time::delay(3.0);
 
-    sendMessage(_expr_port, "set all neu");
+bool ClipMaker::body(Instance& inst, const ClipConfig& cfg, const int from, const int to) {
 
-    yarp::os::Time::delay(3.0);
+    //-- Ensure atomicity of communications.
+    std::lock_guard<std::mutex> lg(inst.lock);
 
-    sendMessage(_expr_port, "set all hap");
+    //-- Right arm goes first when f:0 t:1, f:0 t:2, and f:1 t:2
+    bool right_arm_first = (from < to);
 
-    yarp::os::Time::delay(3.0);
+    const std::vector<double>* r_arm_vec;
+    const std::vector<double>* l_arm_vec;
+    cfg.bodyPoses(from, to, r_arm_vec, l_arm_vec);
 
-    sendMessage(_expr_port, "set all neu");
+    //-- The first arm points at the from peg, the second at the to peg.
+    Limb first  = (right_arm_first ? Limb::RightArm : Limb::LeftArm);
+    Limb second = (right_arm_first ? Limb::LeftArm  : Limb::RightArm);
 
-    yarp::os::Time::delay(3.0);
+    const std::vector<double>* first_home  = (right_arm_first ? &cfg.right_arm_home : &cfg.left_arm_home);
+    const std::vector<double>* second_home = (right_arm_first ? &cfg.left_arm_home  : &cfg.right_arm_home);
+    const std::vector<double>* first_peg   = (right_arm_first ? r_arm_vec : l_arm_vec);
+    const std::vector<double>* second_peg  = (right_arm_first ? l_arm_vec : r_arm_vec);
 
-    sendMessage(_expr_port, "set all shy");
+    //-- Time each arm spends getting to and holding a pose.
+    double hold = (cfg.body_mode == "minjerk" ? cfg.body_traj_time + cfg.body_hold : 3.0);
+    double back = cfg.body_stagger + hold;
 
-    yarp::os::Time::delay(3.0);
+    //-- Don't move either arm unless both are where their trajectories start.
+    if (cfg.body_mode == "minjerk") {
+        if (!atStart(inst, cfg, first,  cfg.trajectory(*first_home,  *first_peg)) ||
+            !atStart(inst, cfg, second, cfg.trajectory(*second_home, *second_peg))) {
+            return false;
+        }
+    }
 
-    sendMessage(_expr_port, "set all neu");
+    //-- Out to the pegs, second arm offset by the stagger, then back in reverse order.
+    cueArm(inst, cfg, first,  0.0,                     *first_home,  *first_peg);
+    cueArm(inst, cfg, second, cfg.body_stagger,        *second_home, *second_peg);
+    cueArm(inst, cfg, second, back,                    *second_peg,  *second_home);
+    cueArm(inst, cfg, first,  back + cfg.body_stagger, *first_peg,   *first_home);
+    inst.choreo->until(back + cfg.body_stagger + hold);
+
+    //-- Optionally follow the pointing with the gaze, in parallel with the arms.
+    if (cfg.body_gaze) {
+        yarp::sig::Vector from_pos(3, cfg.gazeTarget(from)->data());
+        yarp::sig::Vector to_pos(3,   cfg.gazeTarget(to)->data());
+        yarp::sig::Vector home_pos(cfg.gaze_home.size(), cfg.gaze_home.data());
+
+        inst.choreo->cue(Track::Gaze, 0.0,              [&inst, from_pos] { return inst.robot->lookAtAbsAngles(from_pos); });
+        inst.choreo->cue(Track::Gaze, cfg.body_stagger, [&inst, to_pos]   { return inst.robot->lookAtAbsAngles(to_pos);   });
+        inst.choreo->cue(Track::Gaze, back,             [&inst, home_pos] { return inst.robot->lookAtAbsAngles(home_pos); });
+    }
 
-    return true;
+    return inst.choreo->play();
 }
 
 
-bool ClipMaker::gaze(const int from, const int to) {
+bool ClipMaker::expression(Instance& inst, const ClipConfig& cfg, const int from, const int to) {
 
     //-- Ensure atomicity of communications.
-    std::lock_guard<std::mutex> lg(lock);
+    std::lock_guard<std::mutex> lg(inst.lock);
 
-    //-- Set the gaze to the home position.
-    yarp::sig::Vector home_pos(_gaze_home.size(), _gaze_home.data());
 
-    _gaze->lookAtAbsAngles(home_pos);
-    yarp::os::Time::delay(3.0);
+    //-- Ensure we're starting at neutral, and wait a short while before beginning.
+    double at = 0.0;
+    cueFrame(inst, cfg, at, "neutral");
+    at += 1.0;
 
-    //-- Figure out the two places we're looking at.
-    double* from_data;
-    if (from == 0) from_data = _gaze_left.data();
-    else if (from == 1) from_data = _gaze_mid.data();
-    else if (from == 2) from_data = _gaze_right.data();
+    //-- Move the right eyebrow up and down equal to idx for from
+    //-- (the frames also reset the mouth, it can do strange things...).
+    for (int i = 0; i < (from+1); ++i) {
+        cueFrame(inst, cfg, at,                  "reb_up");
+        cueFrame(inst, cfg, at + cfg.expr_timer, "reb_down");
+        at += 2.0 * cfg.expr_timer;
+    }
 
-    double* to_data;
-    if (to == 0) to_data = _gaze_left.data();
-    else if (to == 1) to_data = _gaze_mid.data();
-    else if (to == 2) to_data = _gaze_right.data();
+    //-- Wait a little bit between hints.
+    at += (1.0 - cfg.expr_timer);
+
+    //-- Move the left eyebrow up and down equal to idx for to.
+    for (int i = 0; i < (to+1); ++i) {
+        cueFrame(inst, cfg, at,                  "leb_up");
+        cueFrame(inst, cfg, at + cfg.expr_timer, "leb_down");
+        at += 2.0 * cfg.expr_timer;
+    }
+
+    //-- Wait a bit of time then show "correct" and "incorrect" guess gestures.
+    for (const char* name : { "neutral", "happy", "neutral", "shy", "neutral" }) {
+        at += 3.0;
+        cueFrame(inst, cfg, at, name);
+    }
+
+    return inst.choreo->play();
+}
 
-    yarp::sig::Vector first_pos(3, from_data);
-    yarp::sig::Vector second_pos(3, to_data);
 
+bool ClipMaker::gaze(Instance& inst, const ClipConfig& cfg, const int from, const int to) {
+
+    //-- Ensure atomicity of communications.
+    std::lock_guard<std::mutex> lg(inst.lock);
+
+    //-- Figure out the home position and the two places we're looking at.
+    yarp::sig::Vector home_pos(cfg.gaze_home.size(), cfg.gaze_home.data());
+    yarp::sig::Vector first_pos(3,  cfg.gazeTarget(from)->data());
+    yarp::sig::Vector second_pos(3, cfg.gazeTarget(to)->data());
+
+    //-- Set the gaze to the home position.
+    double at = 0.0;
+    inst.choreo->cue(Track::Gaze, at, [&inst, home_pos] { return inst.robot->lookAtAbsAngles(home_pos); });
+    at += 3.0;
+
+    //-- Look from one peg to the other a few times.
     for (int idx = 0; idx < 3; ++idx) {
-        _gaze->lookAtAbsAngles(first_pos);
-        yarp::os::Time::delay(1.2);
-        _gaze->lookAtAbsAngles(second_pos);
-        yarp::os::Time::delay(1.2);
+        inst.choreo->cue(Track::Gaze, at,       [&inst, first_pos]  { return inst.robot->lookAtAbsAngles(first_pos);  });
+        inst.choreo->cue(Track::Gaze, at + 1.2, [&inst, second_pos] { return inst.robot->lookAtAbsAngles(second_pos); });
+        at += 2.4;
     }
-    
-    yarp::os::Time::delay(3.0);
-    _gaze->lookAtAbsAngles(home_pos);
 
-    return true;
+    //-- And back home.
+    at += 3.0;
+    inst.choreo->cue(Track::Gaze, at, [&inst, home_pos] { return inst.robot->lookAtAbsAngles(home_pos); });
+
+    return inst.choreo->play();
 }
 
 
-bool ClipMaker::speech() {
+bool ClipMaker::speech(Instance& inst, const ClipConfig& cfg) {
 
     //-- Ensure atomicity of communications.
-    std::lock_guard<std::mutex> lg(lock);
+    std::lock_guard<std::mutex> lg(inst.lock);
 
     //-- Ensure we're starting at neutral.
-    sendMessage(_expr_port, "set all neu"); // reuse expr ports
+    sendFrame(inst, cfg, "neutral"); // reuse expr ports
 
     //-- Wait a short while before beginning.
-    yarp::os::Time::delay(1.0);
+    _clock->delay(1.0);
 
     //-- Move the mouth for the specified amount of time.
-    double start_time = yarp::os::Time::now();
-    while ((yarp::os::Time::now() - start_time) < _spch_timer) {
+    const FaceFrame& mouth_open   = cfg.face_frames.at("mouth_open");
+    const FaceFrame& mouth_closed = cfg.face_frames.at("mouth_closed");
+
+    //-- Step through the pattern on absolute deadlines so that late wake ups
+    //-- don't accumulate. Only start a new syllable while there's time left.
+    double start_time = _clock->now();
+    double deadline   = start_time;
+    for (std::size_t step = 0; ; ++step) {
 
-        sendMessage(_expr_port, "set mou surp");
-        yarp::os::Time::delay(0.2);
-        sendMessage(_expr_port, "set mou neu");
-        yarp::os::Time::delay(0.2);
+        bool open = (step % 2 == 0);
+        if (open && (deadline - start_time) >= cfg.spch_timer) break;
 
+        inst.robot->sendFace(open ? mouth_open : mouth_closed);
+
+        deadline += cfg.spch_pattern[step % cfg.spch_pattern.size()];
+        _clock->delayUntil(deadline);
+        inst.jitter.add(_clock->now() - deadline);
     }
 
     return true;
 }
 
 
-void ClipMaker::sendMessage(yarp::os::Port& port, const std::string msg) {
-    
-    //-- Make a bottle.
-    yarp::os::Bottle bot; bot.clear();
-
-    //-- Parse this string up into individual words.
-    std::istringstream ss(msg);
+void ClipMaker::cueArm(Instance& inst, const ClipConfig& cfg, Limb limb, double at, const std::vector<double>& from, const std::vector<double>& to) {
 
-    //-- Add each word to the bottle.
-    std::string word;
-    while (ss >> word)
-        bot.addString(word);
+    Track track = (limb == Limb::LeftArm ? Track::LeftArm : Track::RightArm);
 
-    //-- Write it out on the port.
-    port.write(bot);
+    //-- Streamed moves block the arm's track for the trajectory duration.
+    if (cfg.body_mode == "minjerk") {
+        const Trajectory* traj = &cfg.trajectory(from, to);
+        inst.choreo->cue(track, at, [this, &inst, &cfg, limb, traj] { return streamTrajectory(inst, cfg, limb, *traj); });
+    } else {
+        const double* pos = to.data();
+        inst.choreo->cue(track, at, [&inst, limb, pos] { return inst.robot->positionMove(limb, pos); });
+    }
 
     return;
 }
 
 
-bool ClipMaker::loadBottleAsVec(yarp::os::Bottle* bot, std::vector<double>& vec) {
+bool ClipMaker::streamTrajectory(Instance& inst, const ClipConfig& cfg, Limb limb, const Trajectory& traj) {
 
-    //-- If bottle couldn't be loaded, return false.
-    if (bot == NULL) { return false; }
+    double period = 1.0 / cfg.body_stream_rate;
 
-    //-- Clear out the vector and push the vectors contents into it.
-    vec.clear();
-    for (int idx = 0; idx < bot->size(); ++idx) {
-        vec.push_back(bot->get(idx).asFloat64());
+    //-- The way back starts wherever the way out left the arm.
+    if (!atStart(inst, cfg, limb, traj)) {
+        return false;
+    }
+
+    if (!inst.robot->setDirectMode(limb, true)) {
+        return false;
+    }
+
+    //-- Each tick is scheduled from the start time so waits don't drift.
+    bool ok = true;
+    double start = _clock->now();
+    for (std::size_t tick = 0; tick < traj.size() && ok; ++tick) {
+
+        ok &= inst.robot->setPositions(limb, traj.at(tick * period));
+
+        if (tick+1 < traj.size()) _clock->delayUntil(start + (tick+1) * period);
+    }
+
+    //-- Hand the arm back to position mode for home and positionMove.
+    inst.robot->setDirectMode(limb, false);
+
+    return ok;
+}
+
+
+bool ClipMaker::atStart(Instance& inst, const ClipConfig& cfg, Limb limb, const Trajectory& traj) {
+
+    std::vector<double> measured(_num_joints);
+    if (!inst.robot->getPositions(limb, measured.data())) {
+        yWarning("%s: Unable to read the %s encoders!!", this->getName().c_str(), Robot::limbName(limb).c_str());
+        return false;
+    }
+
+    //-- Largest error over the joints.
+    const double* start = traj.at(0.0);
+    double error = 0.0;
+    for (std::size_t joint = 0; joint < measured.size(); ++joint) {
+        error = std::max(error, std::fabs(measured[joint] - start[joint]));
+    }
+
+    if (error > cfg.body_start_tolerance) {
+        yWarning("%s: The %s is %.1f degrees from where its trajectory starts, home it first!!", 
+            this->getName().c_str(), Robot::limbName(limb).c_str(), error);
+        return false;
     }
 
-    //-- Return success.
     return true;
 }
+
+
+void ClipMaker::cueFrame(Instance& inst, const ClipConfig& cfg, double at, const std::string name) {
+
+    auto it = cfg.face_frames.find(name);
+    if (it == cfg.face_frames.end()) {
+        yWarning("%s: Unknown face frame ``%s``", this->getName().c_str(), name.c_str());
+        return;
+    }
+
+    //-- The config outlives play(), so the frame can be sent from it directly.
+    const FaceFrame* frame = &it->second;
+    inst.choreo->cue(Track::Face, at, [&inst, frame] { return inst.robot->sendFace(*frame); });
+
+    return;
+}
+
+
+void ClipMaker::sendFrame(Instance& inst, const ClipConfig& cfg, const std::string name) {
+
+    auto it = cfg.face_frames.find(name);
+    if (it == cfg.face_frames.end()) {
+        yWarning("%s: Unknown face frame ``%s``", this->getName().c_str(), name.c_str());
+        return;
+    }
+
+    //-- Write it out to the face.
+    inst.robot->sendFace(it->second);
+
+    return;
+}
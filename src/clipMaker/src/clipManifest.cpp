@@ -0,0 +1,122 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <clipManifest.hpp>
+
+
+ClipManifest::ClipManifest() {
+    _opened = false;
+}
+
+
+ClipManifest::~ClipManifest() {
+    _entries.clear();
+    _tags.clear();
+}
+
+
+bool ClipManifest::openManifest(std::string fname) {
+
+    _fname = fname;
+    _entries.clear();
+    _tags.clear();
+    _opened = true;
+
+    //-- No manifest yet means nothing has been generated.
+    std::ifstream input(_fname);
+    if (!input.is_open()) {
+        return true;
+    }
+
+    //-- Each line is ``<behavior> <from> <to> <hash> [<tag>]``.
+    std::string line;
+    while (getline(input, line)) {
+
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream ss(line);
+        std::string behavior, hash;
+        int from, to;
+        if (!(ss >> behavior >> from >> to >> hash)) {
+            std::cerr << "Skipping malformed manifest line: " << line << std::endl;
+            continue;
+        }
+
+        std::string key = makeKey(behavior, from, to);
+        _entries[key] = hash;
+
+        std::string tag;
+        if (ss >> tag) _tags[key] = tag;
+    }
+
+    return true;
+}
+
+
+bool ClipManifest::saveManifest() {
+
+    if (!_opened) {
+        return false;
+    }
+
+    std::ofstream output(_fname, std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Unable to write manifest " << _fname << std::endl;
+        return false;
+    }
+
+    output << "# behavior from to hash tag" << std::endl;
+    for (const auto& entry : _entries) {
+        output << entry.first << " " << entry.second;
+
+        auto tag = _tags.find(entry.first);
+        if (tag != _tags.end() && !tag->second.empty()) {
+            output << " " << tag->second;
+        }
+        output << std::endl;
+    }
+
+    return true;
+}
+
+
+bool ClipManifest::isCurrent(std::string key, std::string hash) {
+    auto it = _entries.find(key);
+    return (it != _entries.end() && it->second == hash);
+}
+
+
+void ClipManifest::update(std::string key, std::string hash, std::string tag/*=""*/) {
+    _entries[key] = hash;
+    _tags[key]    = tag;
+    return;
+}
+
+
+std::string ClipManifest::makeKey(std::string behavior, int from, int to) {
+    return behavior + " " + std::to_string(from) + " " + std::to_string(to);
+}
+
+
+std::string ClipManifest::hash(const std::string& content) {
+
+    //-- FNV-1a, 64 bit.
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : content) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+
+    std::ostringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << h;
+    return ss.str();
+}
@@ -0,0 +1,74 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <clock.hpp>
+
+
+double SystemClock::now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+void SystemClock::delay(double seconds) {
+    if (seconds <= 0.0) return;
+    delayUntil(now() + seconds);
+    return;
+}
+
+
+void SystemClock::delayUntil(double deadline) {
+
+    struct timespec ts;
+    double secs = std::floor(deadline);
+    ts.tv_sec  = static_cast<time_t>(secs);
+    ts.tv_nsec = static_cast<long>((deadline - secs) * 1e9);
+
+    //-- Sleep to the absolute time, resuming if a signal wakes us early.
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+
+    return;
+}
+
+
+VirtualClock::VirtualClock(double warp/*=1.0*/) :
+    _epoch(std::chrono::steady_clock::now()), _warp(warp) {
+
+    //-- Guard against a nonsensical warp.
+    if (_warp <= 0.0) {
+        _warp = 1.0;
+    }
+
+    return;
+}
+
+
+double VirtualClock::now() {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _epoch;
+    return elapsed.count() * _warp;
+}
+
+
+void VirtualClock::delay(double seconds) {
+    if (seconds <= 0.0) return;
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds / _warp));
+    return;
+}
+
+
+void VirtualClock::delayUntil(double deadline) {
+    auto wake = _epoch + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(deadline / _warp));
+    std::this_thread::sleep_until(wake);
+    return;
+}
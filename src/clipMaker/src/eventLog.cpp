@@ -0,0 +1,145 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <eventLog.hpp>
+
+
+EventLog::EventLog(std::size_t capacity) :
+    _events(capacity), _next(0), _start(0.0), _start_wall(0.0) {
+}
+
+
+void EventLog::start(double now) {
+    _next.store(0);
+    _start      = now;
+    _start_wall = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return;
+}
+
+
+void EventLog::record(double now, EventTarget target, EventCommand command, 
+    const double* values, std::size_t count, const char* text/*=nullptr*/) {
+
+    //-- Claim a slot; once full, later events only bump the counter.
+    std::size_t idx = _next.fetch_add(1);
+    if (idx >= _events.size()) return;
+
+    Event& event  = _events[idx];
+    event.stamp   = now - _start;
+    event.target  = target;
+    event.command = command;
+    event.count   = static_cast<uint16_t>(std::min(count, Event::MAX_VALUES));
+    for (std::size_t val = 0; val < event.count; ++val) {
+        event.values[val] = values[val];
+    }
+
+    event.text[0] = '\0';
+    if (text) {
+        std::strncpy(event.text, text, Event::MAX_TEXT-1);
+        event.text[Event::MAX_TEXT-1] = '\0';
+    }
+
+    return;
+}
+
+
+std::size_t EventLog::size() const {
+    return std::min(_next.load(), _events.size());
+}
+
+
+std::size_t EventLog::dropped() const {
+    std::size_t next = _next.load();
+    return (next > _events.size() ? next - _events.size() : 0);
+}
+
+
+bool EventLog::write(const std::string fname, const std::string tag) const {
+
+    FILE* output = std::fopen(fname.c_str(), "w");
+    if (output == NULL) {
+        std::fprintf(stderr, "Unable to write event log %s\n", fname.c_str());
+        return false;
+    }
+
+    std::fprintf(output, "# instance %s\n", tag.c_str());
+    std::fprintf(output, "# start %.6f wall %.6f\n", _start, _start_wall);
+    std::fprintf(output, "# dropped %zu\n", dropped());
+    std::fprintf(output, "# stamp target command args\n");
+
+    for (std::size_t idx = 0; idx < size(); ++idx) {
+
+        const Event& event = _events[idx];
+        std::fprintf(output, "%.6f %s %s", event.stamp, targetName(event.target), commandName(event.command));
+        for (std::size_t val = 0; val < event.count; ++val) {
+            std::fprintf(output, " %g", event.values[val]);
+        }
+        if (event.text[0] != '\0') {
+            std::fprintf(output, " %s", event.text);
+        }
+        std::fprintf(output, "\n");
+    }
+
+    std::fclose(output);
+    return true;
+}
+
+
+void EventLog::addTo(yarp::os::Bottle& bot, const std::string key, const std::string tag) const {
+
+    bot.addString(key);
+    bot.addString(tag);
+    bot.addFloat64(_start);
+    bot.addFloat64(_start_wall);
+
+    for (std::size_t idx = 0; idx < size(); ++idx) {
+
+        const Event& event = _events[idx];
+        yarp::os::Bottle& entry = bot.addList();
+        entry.addFloat64(event.stamp);
+        entry.addString(targetName(event.target));
+        entry.addString(commandName(event.command));
+        for (std::size_t val = 0; val < event.count; ++val) {
+            entry.addFloat64(event.values[val]);
+        }
+        if (event.text[0] != '\0') {
+            entry.addString(event.text);
+        }
+    }
+
+    return;
+}
+
+
+const char* EventLog::targetName(EventTarget target) {
+    switch (target) {
+        case EventTarget::LeftArm:  return "left_arm";
+        case EventTarget::RightArm: return "right_arm";
+        case EventTarget::Gaze:     return "gaze";
+        case EventTarget::Face:     return "face";
+    }
+    return "unknown";
+}
+
+
+const char* EventLog::commandName(EventCommand command) {
+    switch (command) {
+        case EventCommand::SetRefSpeed:    return "setRefSpeed";
+        case EventCommand::PositionMove:   return "positionMove";
+        case EventCommand::SetControlMode: return "setControlMode";
+        case EventCommand::SetPositions:   return "setPositions";
+        case EventCommand::SetTrajTime:    return "setTrajTime";
+        case EventCommand::LookAt:         return "lookAtAbsAngles";
+        case EventCommand::Write:          return "write";
+    }
+    return "unknown";
+}
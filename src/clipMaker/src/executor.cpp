@@ -0,0 +1,72 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <executor.hpp>
+
+
+Executor::Executor(std::function<void()> on_start/*=nullptr*/) :
+    _stopping(false) {
+    _thread = std::thread(&Executor::loop, this, on_start);
+}
+
+
+Executor::~Executor() {
+
+    {
+        std::lock_guard<std::mutex> lg(_lock);
+        _stopping = true;
+    }
+    _wake.notify_all();
+
+    if (_thread.joinable()) _thread.join();
+}
+
+
+std::future<bool> Executor::submit(std::function<bool()> job) {
+
+    std::packaged_task<bool()> task(job);
+    std::future<bool> result = task.get_future();
+
+    {
+        std::lock_guard<std::mutex> lg(_lock);
+        _jobs.push_back(std::move(task));
+    }
+    _wake.notify_one();
+
+    return result;
+}
+
+
+bool Executor::run(std::function<bool()> job) {
+    return submit(job).get();
+}
+
+
+void Executor::loop(std::function<void()> on_start) {
+
+    if (on_start) on_start();
+
+    while (true) {
+
+        std::packaged_task<bool()> task;
+        {
+            std::unique_lock<std::mutex> lk(_lock);
+            _wake.wait(lk, [this] { return _stopping || !_jobs.empty(); });
+            if (_jobs.empty()) return; // stopping, and nothing left to do.
+
+            task = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        task();
+    }
+}
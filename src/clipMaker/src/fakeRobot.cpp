@@ -0,0 +1,174 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <fakeRobot.hpp>
+
+
+FakeRobot::FakeRobot(Clock& clock, int num_joints) :
+    _clock(clock), _num_joints(num_joints), 
+    _left_arm_positions(num_joints, 0.0), _right_arm_positions(num_joints, 0.0) {
+    _timeline_start = _clock.now();
+}
+
+
+bool FakeRobot::open() {
+    startTimeline();
+    return true;
+}
+
+
+void FakeRobot::interrupt() {
+    return;
+}
+
+
+void FakeRobot::close() {
+    return;
+}
+
+
+bool FakeRobot::setRefSpeed(double speed) {
+    std::ostringstream ss;
+    ss << speed;
+    record("left_arm",  "setRefSpeed", ss.str());
+    record("right_arm", "setRefSpeed", ss.str());
+    return true;
+}
+
+
+bool FakeRobot::positionMove(Limb limb, const double* pos) {
+    std::ostringstream ss;
+    for (int joint = 0; joint < _num_joints; ++joint) {
+        ss << (joint ? " " : "") << pos[joint];
+    }
+    record(limbName(limb), "positionMove", ss.str());
+    moveTo(limb, pos);
+    return true;
+}
+
+
+bool FakeRobot::hasPositionDirect() {
+    return true;
+}
+
+
+bool FakeRobot::setDirectMode(Limb limb, bool direct) {
+    record(limbName(limb), "setControlMode", (direct ? "position_direct" : "position"));
+    return true;
+}
+
+
+bool FakeRobot::setPositions(Limb limb, const double* pos) {
+    std::ostringstream ss;
+    for (int joint = 0; joint < _num_joints; ++joint) {
+        ss << (joint ? " " : "") << pos[joint];
+    }
+    record(limbName(limb), "setPositions", ss.str());
+    moveTo(limb, pos);
+    return true;
+}
+
+
+bool FakeRobot::getPositions(Limb limb, double* pos) {
+    std::lock_guard<std::mutex> lg(_positions_lock);
+    const std::vector<double>& arm = (limb == Limb::LeftArm ? _left_arm_positions : _right_arm_positions);
+    std::copy(arm.begin(), arm.end(), pos);
+    return true;
+}
+
+
+bool FakeRobot::checkMotionDone(Limb limb, bool& done) {
+    done = true;
+    return true;
+}
+
+
+bool FakeRobot::setGazeTrajTime(double neck, double eyes) {
+    std::ostringstream ss;
+    ss << neck << " " << eyes;
+    record("gaze", "setTrajTime", ss.str());
+    return true;
+}
+
+
+bool FakeRobot::lookAtAbsAngles(const yarp::sig::Vector& ang) {
+    std::ostringstream ss;
+    for (std::size_t idx = 0; idx < ang.size(); ++idx) {
+        ss << (idx ? " " : "") << ang[idx];
+    }
+    record("gaze", "lookAtAbsAngles", ss.str());
+    return true;
+}
+
+
+bool FakeRobot::sendFace(const FaceFrame& frame) {
+    std::ostringstream ss;
+    for (std::size_t idx = 0; idx < frame.size(); ++idx) {
+        ss << (idx ? " | " : "") << frame[idx].toString();
+    }
+    record("face", "write", ss.str());
+    return true;
+}
+
+
+void FakeRobot::startTimeline() {
+    std::lock_guard<std::mutex> lg(_timeline_lock);
+    _timeline.clear();
+    _timeline_start = _clock.now();
+    return;
+}
+
+
+std::vector<TimelineEntry> FakeRobot::getTimeline() {
+    std::lock_guard<std::mutex> lg(_timeline_lock);
+    return _timeline;
+}
+
+
+bool FakeRobot::writeTimeline(std::string fname, std::string tag/*=""*/) {
+
+    std::ofstream output(fname, std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Unable to write timeline " << fname << std::endl;
+        return false;
+    }
+
+    //-- The total time is how long the behavior took in virtual seconds.
+    std::lock_guard<std::mutex> lg(_timeline_lock);
+    output << std::fixed << std::setprecision(3);
+    output << "# instance " << tag << std::endl;
+    output << "# total " << (_clock.now() - _timeline_start) << std::endl;
+    output << "# stamp target command args" << std::endl;
+    for (const TimelineEntry& entry : _timeline) {
+        output << entry.stamp   << " "
+               << entry.target  << " "
+               << entry.command << " "
+               << entry.args    << std::endl;
+    }
+
+    return true;
+}
+
+
+void FakeRobot::moveTo(Limb limb, const double* pos) {
+    std::lock_guard<std::mutex> lg(_positions_lock);
+    std::vector<double>& arm = (limb == Limb::LeftArm ? _left_arm_positions : _right_arm_positions);
+    std::copy(pos, pos + _num_joints, arm.begin());
+    return;
+}
+
+
+void FakeRobot::record(std::string target, std::string command, std::string args) {
+    std::lock_guard<std::mutex> lg(_timeline_lock);
+    _timeline.push_back({ _clock.now() - _timeline_start, target, command, args });
+    return;
+}
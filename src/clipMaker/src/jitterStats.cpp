@@ -0,0 +1,73 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <jitterStats.hpp>
+
+
+JitterStats::JitterStats() {
+    clear();
+}
+
+
+void JitterStats::clear() {
+    _count = 0;
+    _mean  = 0.0;
+    _m2    = 0.0;
+    _max   = 0.0;
+    return;
+}
+
+
+void JitterStats::add(double lateness) {
+
+    _count++;
+    double delta = lateness - _mean;
+    _mean += delta / _count;
+    _m2   += delta * (lateness - _mean);
+
+    _max = (_count == 1 ? lateness : std::max(_max, lateness));
+
+    return;
+}
+
+
+std::size_t JitterStats::count() const {
+    return _count;
+}
+
+
+double JitterStats::mean() const {
+    return _mean;
+}
+
+
+double JitterStats::max() const {
+    return _max;
+}
+
+
+double JitterStats::stddev() const {
+    return (_count > 1 ? std::sqrt(_m2 / (_count - 1)) : 0.0);
+}
+
+
+void JitterStats::addTo(yarp::os::Bottle& reply, const std::string name) const {
+
+    yarp::os::Bottle& stats = reply.addList();
+    stats.addString(name);
+    stats.addString("n");    stats.addInt32(static_cast<int>(_count));
+    stats.addString("mean"); stats.addFloat64(mean());
+    stats.addString("max");  stats.addFloat64(max());
+    stats.addString("std");  stats.addFloat64(stddev());
+
+    return;
+}
@@ -0,0 +1,60 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <jobQueue.hpp>
+
+
+JobQueue::JobQueue(std::size_t num_workers) :
+    _queues(num_workers) {
+
+    for (std::size_t idx = 0; idx < num_workers; ++idx) {
+        _locks.emplace_back(new std::mutex());
+    }
+
+    return;
+}
+
+
+void JobQueue::push(std::size_t worker, const ClipJob& job) {
+    std::lock_guard<std::mutex> lg(*_locks[worker]);
+    _queues[worker].push_back(job);
+    return;
+}
+
+
+bool JobQueue::pop(std::size_t worker, ClipJob& job) {
+
+    //-- Own work first, oldest job first.
+    {
+        std::lock_guard<std::mutex> lg(*_locks[worker]);
+        if (!_queues[worker].empty()) {
+            job = _queues[worker].front();
+            _queues[worker].pop_front();
+            return true;
+        }
+    }
+
+    //-- Steal the newest job from the next worker that has any.
+    for (std::size_t offset = 1; offset < _queues.size(); ++offset) {
+
+        std::size_t victim = (worker + offset) % _queues.size();
+
+        std::lock_guard<std::mutex> lg(*_locks[victim]);
+        if (!_queues[victim].empty()) {
+            job = _queues[victim].back();
+            _queues[victim].pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,115 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <loggedRobot.hpp>
+
+
+LoggedRobot::LoggedRobot(Robot* robot, EventLog& log, Clock& clock, int num_joints) :
+    _robot(robot), _log(log), _clock(clock), _num_joints(num_joints) {
+}
+
+
+bool LoggedRobot::open() {
+    return _robot->open();
+}
+
+
+void LoggedRobot::interrupt() {
+    _robot->interrupt();
+    return;
+}
+
+
+void LoggedRobot::close() {
+    _robot->close();
+    return;
+}
+
+
+bool LoggedRobot::setRefSpeed(double speed) {
+    double now = _clock.now();
+    _log.record(now, EventTarget::LeftArm,  EventCommand::SetRefSpeed, &speed, 1);
+    _log.record(now, EventTarget::RightArm, EventCommand::SetRefSpeed, &speed, 1);
+    return _robot->setRefSpeed(speed);
+}
+
+
+bool LoggedRobot::positionMove(Limb limb, const double* pos) {
+    _log.record(_clock.now(), limbTarget(limb), EventCommand::PositionMove, pos, _num_joints);
+    return _robot->positionMove(limb, pos);
+}
+
+
+bool LoggedRobot::hasPositionDirect() {
+    return _robot->hasPositionDirect();
+}
+
+
+bool LoggedRobot::setDirectMode(Limb limb, bool direct) {
+    _log.record(_clock.now(), limbTarget(limb), EventCommand::SetControlMode, 
+        nullptr, 0, (direct ? "position_direct" : "position"));
+    return _robot->setDirectMode(limb, direct);
+}
+
+
+bool LoggedRobot::setPositions(Limb limb, const double* pos) {
+    _log.record(_clock.now(), limbTarget(limb), EventCommand::SetPositions, pos, _num_joints);
+    return _robot->setPositions(limb, pos);
+}
+
+
+bool LoggedRobot::getPositions(Limb limb, double* pos) {
+    return _robot->getPositions(limb, pos);
+}
+
+
+bool LoggedRobot::checkMotionDone(Limb limb, bool& done) {
+    return _robot->checkMotionDone(limb, done);
+}
+
+
+bool LoggedRobot::setGazeTrajTime(double neck, double eyes) {
+    double times[2] = { neck, eyes };
+    _log.record(_clock.now(), EventTarget::Gaze, EventCommand::SetTrajTime, times, 2);
+    return _robot->setGazeTrajTime(neck, eyes);
+}
+
+
+bool LoggedRobot::lookAtAbsAngles(const yarp::sig::Vector& ang) {
+    _log.record(_clock.now(), EventTarget::Gaze, EventCommand::LookAt, ang.data(), ang.size());
+    return _robot->lookAtAbsAngles(ang);
+}
+
+
+bool LoggedRobot::sendFace(const FaceFrame& frame) {
+
+    //-- Join the parts as "set reb sur|set mou neu" in a fixed buffer.
+    char text[Event::MAX_TEXT];
+    std::size_t len = 0;
+    text[0] = '\0';
+    for (std::size_t part = 0; part < frame.size(); ++part) {
+        for (std::size_t word = 0; word < frame[part].size(); ++word) {
+            const char* sep = (word ? "_" : (part ? "|" : ""));
+            int n = std::snprintf(text + len, sizeof(text) - len, "%s%s", sep, frame[part].get(word).asString().c_str());
+            if (n < 0) break;
+            len = std::min(len + n, sizeof(text) - 1);
+        }
+    }
+
+    _log.record(_clock.now(), EventTarget::Face, EventCommand::Write, nullptr, 0, text);
+    return _robot->sendFace(frame);
+}
+
+
+EventTarget LoggedRobot::limbTarget(Limb limb) {
+    return (limb == Limb::LeftArm ? EventTarget::LeftArm : EventTarget::RightArm);
+}
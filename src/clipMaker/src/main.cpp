@@ -39,5 +39,6 @@ int main (int argc, char **argv) {
 
     //-- Run the interface and return its status.
     ClipMaker clip_maker;
+    clip_maker.setCommandLine(argc, argv);
     return clip_maker.runModule(rf);
 }
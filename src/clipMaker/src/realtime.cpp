@@ -0,0 +1,122 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <realtime.hpp>
+
+
+bool Realtime::check(const RealtimeConfig& cfg, std::string& error) {
+
+    int min_priority = sched_get_priority_min(SCHED_FIFO);
+    int max_priority = sched_get_priority_max(SCHED_FIFO);
+    if (cfg.priority < min_priority || cfg.priority > max_priority) {
+        error = "rt_priority must be within [" + std::to_string(min_priority) + ", " + std::to_string(max_priority) + "]";
+        return false;
+    }
+
+    for (int cpu : cfg.cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            error = "rt_cpus must be within [0, " + std::to_string(CPU_SETSIZE) + ")";
+            return false;
+        }
+    }
+
+    if (cfg.prefault_stack > MAX_PREFAULT_STACK) {
+        error = "rt_prefault_stack must be at most " + std::to_string(MAX_PREFAULT_STACK) + " bytes";
+        return false;
+    }
+
+    return true;
+}
+
+
+bool Realtime::setupProcess(const RealtimeConfig& cfg) {
+
+    bool ok = true;
+
+    if (cfg.lock_memory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            yWarning("Unable to lock memory (%s), continuing without.", std::strerror(errno));
+            ok = false;
+        }
+    }
+
+    if (cfg.prefault_heap > 0) {
+
+        //-- Keep freed memory in the heap instead of handing it back, so the
+        //-- pages touched here stay resident for later allocations.
+        mallopt(M_TRIM_THRESHOLD, -1);
+        mallopt(M_MMAP_MAX, 0);
+
+        long page = sysconf(_SC_PAGESIZE);
+        char* heap = static_cast<char*>(std::malloc(cfg.prefault_heap));
+        if (heap) {
+            for (std::size_t idx = 0; idx < cfg.prefault_heap; idx += page) {
+                heap[idx] = 0;
+            }
+            std::free(heap);
+        } else {
+            yWarning("Unable to prefault %zu bytes of heap.", cfg.prefault_heap);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+
+bool Realtime::setupThread(const RealtimeConfig& cfg) {
+
+    bool ok = true;
+
+    //-- Pin the thread to the given cpus.
+    if (!cfg.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cfg.cpus) CPU_SET(cpu, &set);
+
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err != 0) {
+            yWarning("Unable to set cpu affinity (%s), continuing without.", std::strerror(err));
+            ok = false;
+        }
+    }
+
+    //-- Real-time FIFO scheduling.
+    struct sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = cfg.priority;
+
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+        yWarning("Unable to set SCHED_FIFO priority %d (%s), continuing without.", cfg.priority, std::strerror(err));
+        ok = false;
+    }
+
+    prefaultStack(cfg.prefault_stack);
+
+    return ok;
+}
+
+
+void Realtime::prefaultStack(std::size_t size) {
+
+    if (size == 0) return;
+
+    //-- volatile so the writes aren't optimized away.
+    volatile char* stack = static_cast<volatile char*>(alloca(size));
+    long page = sysconf(_SC_PAGESIZE);
+    for (std::size_t idx = 0; idx < size; idx += page) {
+        stack[idx] = 0;
+    }
+
+    return;
+}
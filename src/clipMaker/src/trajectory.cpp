@@ -0,0 +1,63 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <trajectory.hpp>
+
+
+Trajectory::Trajectory() :
+    _num_joints(0), _num_samples(0), _duration(0.0), _period(1.0) {
+}
+
+
+Trajectory::Trajectory(const std::vector<double>& from, const std::vector<double>& to, double duration, double period) :
+    _num_joints(std::min(from.size(), to.size())), _duration(duration), _period(period) {
+
+    //-- One sample per period, including both ends.
+    _num_samples = static_cast<std::size_t>(std::ceil(_duration / _period)) + 1;
+    _samples.resize(_num_samples * _num_joints);
+
+    for (std::size_t idx = 0; idx < _num_samples; ++idx) {
+
+        //-- Normalized time, and the minimum-jerk blend 10t^3 - 15t^4 + 6t^5.
+        double tau = (_duration > 0.0 ? std::min(1.0, (idx * _period) / _duration) : 1.0);
+        double s   = tau*tau*tau * (10.0 - 15.0*tau + 6.0*tau*tau);
+
+        double* row = &_samples[idx * _num_joints];
+        for (std::size_t joint = 0; joint < _num_joints; ++joint) {
+            row[joint] = from[joint] + (to[joint] - from[joint]) * s;
+        }
+    }
+
+    return;
+}
+
+
+const double* Trajectory::at(double t) const {
+
+    if (_num_samples == 0) return nullptr;
+
+    //-- Round to the nearest sample and clamp to the ends.
+    double pos = std::round(t / _period);
+    std::size_t idx = (pos <= 0.0 ? 0 : std::min(static_cast<std::size_t>(pos), _num_samples - 1));
+
+    return &_samples[idx * _num_joints];
+}
+
+
+double Trajectory::duration() const {
+    return _duration;
+}
+
+
+std::size_t Trajectory::size() const {
+    return _num_samples;
+}
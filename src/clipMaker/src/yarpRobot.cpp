@@ -0,0 +1,205 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <yarpRobot.hpp>
+
+
+YarpRobot::YarpRobot(std::string local_name, std::string robot_name, std::string gaze_remote, int num_joints) :
+    _local_name(local_name), _robot_name(robot_name), _gaze_remote(gaze_remote), _num_joints(num_joints),
+    _left_arm_pos(nullptr), _right_arm_pos(nullptr), _left_arm_enc(nullptr), _right_arm_enc(nullptr),
+    _left_arm_dir(nullptr), _right_arm_dir(nullptr), _left_arm_mode(nullptr), _right_arm_mode(nullptr),
+    _gaze(nullptr), _gaze_startup_context(-1) {
+}
+
+
+bool YarpRobot::open() {
+
+    bool ok = true;
+    ok &= _expr_port.open(_local_name + "/expr:o");
+    if (!ok) {
+        yInfo("%s: Unable to open control ports!!", _local_name.c_str());
+        return false;
+    }
+
+
+    //-- Prepare the joint interfaces.
+    yarp::os::Property opt_left_arm;
+    opt_left_arm.put("device","remote_controlboard");
+    opt_left_arm.put("remote","/"+_robot_name+"/left_arm");
+    opt_left_arm.put("local","/"+_local_name+"/left_arm");
+    if (!_left_arm.open(opt_left_arm)) {
+        yInfo("%s: Unable to open %s left arm!!", _robot_name.c_str(), _local_name.c_str());
+        return false;
+    }
+
+    yarp::os::Property opt_right_arm;
+    opt_right_arm.put("device","remote_controlboard");
+    opt_right_arm.put("remote","/"+_robot_name+"/right_arm");
+    opt_right_arm.put("local","/"+_local_name+"/right_arm");
+    if (!_right_arm.open(opt_right_arm)) {
+        yInfo("%s: Unable to open %s right arm!!", _robot_name.c_str(), _local_name.c_str());
+        return false;
+    }
+
+
+    //-- Attach the position controllers and encoders.
+    ok &= _left_arm.view(_left_arm_pos);
+    ok &= _right_arm.view(_right_arm_pos);
+    ok &= _left_arm.view(_left_arm_enc);
+    ok &= _right_arm.view(_right_arm_enc);
+    if (!ok) {
+        yInfo("%s: Unable to open position interfaces!!", _local_name.c_str());
+        return false;
+    }
+
+
+    //-- The streaming interfaces are optional; without them only positionMove works.
+    bool direct = true;
+    direct &= _left_arm.view(_left_arm_dir)   && _left_arm.view(_left_arm_mode);
+    direct &= _right_arm.view(_right_arm_dir) && _right_arm.view(_right_arm_mode);
+    if (!direct) {
+        yWarning("%s: Position-direct interfaces unavailable on %s!!", _local_name.c_str(), _robot_name.c_str());
+        _left_arm_dir  = _right_arm_dir  = nullptr;
+        _left_arm_mode = _right_arm_mode = nullptr;
+    }
+
+
+    //-- Init the gaze vars.
+    yarp::os::Property opt_gaze;
+    opt_gaze.put("device","gazecontrollerclient");
+    opt_gaze.put("remote",_gaze_remote);
+    opt_gaze.put("local","/"+_local_name+"/gaze");
+    if (!_gaze_client.open(opt_gaze)) {
+        yInfo("%s: Unable to open %s gaze control client!!", _robot_name.c_str(), _local_name.c_str());
+        return false;
+    }
+
+
+    //-- Attach the gaze controller.
+    ok &= _gaze_client.view(_gaze);
+    if (!ok) {
+        yInfo("%s: Unable to open %s gaze control client!!", _robot_name.c_str(), _local_name.c_str());
+        return false;
+    }
+
+
+    //-- Set up a restoration point.
+    _gaze->storeContext(&_gaze_startup_context);
+
+    return true;
+}
+
+
+void YarpRobot::interrupt() {
+
+    _expr_port.interrupt();
+
+    if (_gaze) {
+        _gaze->stopControl();
+        _gaze->restoreContext(_gaze_startup_context);
+    }
+
+    return;
+}
+
+
+void YarpRobot::close() {
+
+    _expr_port.close();
+
+    _left_arm.close();
+    _right_arm.close();
+
+    _gaze_client.close();
+
+    return;
+}
+
+
+bool YarpRobot::setRefSpeed(double speed) {
+    bool ok = true;
+    for (int joint = 0; joint < _num_joints; ++joint) {
+        ok &= _left_arm_pos->setRefSpeed(joint, speed);
+        ok &= _right_arm_pos->setRefSpeed(joint, speed);
+    }
+    return ok;
+}
+
+
+bool YarpRobot::positionMove(Limb limb, const double* pos) {
+    yarp::dev::IPositionControl* arm = (limb == Limb::LeftArm ? _left_arm_pos : _right_arm_pos);
+    return arm->positionMove(pos);
+}
+
+
+bool YarpRobot::hasPositionDirect() {
+    return (_left_arm_dir && _right_arm_dir && _left_arm_mode && _right_arm_mode);
+}
+
+
+bool YarpRobot::setDirectMode(Limb limb, bool direct) {
+
+    if (!hasPositionDirect()) return false;
+
+    yarp::dev::IControlMode* mode = (limb == Limb::LeftArm ? _left_arm_mode : _right_arm_mode);
+    int vocab = (direct ? VOCAB_CM_POSITION_DIRECT : VOCAB_CM_POSITION);
+
+    bool ok = true;
+    for (int joint = 0; joint < _num_joints; ++joint) {
+        ok &= mode->setControlMode(joint, vocab);
+    }
+    return ok;
+}
+
+
+bool YarpRobot::setPositions(Limb limb, const double* pos) {
+    yarp::dev::IPositionDirect* arm = (limb == Limb::LeftArm ? _left_arm_dir : _right_arm_dir);
+    return (arm ? arm->setPositions(pos) : false);
+}
+
+
+bool YarpRobot::getPositions(Limb limb, double* pos) {
+    yarp::dev::IEncoders* enc = (limb == Limb::LeftArm ? _left_arm_enc : _right_arm_enc);
+    return enc->getEncoders(pos);
+}
+
+
+bool YarpRobot::checkMotionDone(Limb limb, bool& done) {
+    yarp::dev::IPositionControl* arm = (limb == Limb::LeftArm ? _left_arm_pos : _right_arm_pos);
+    return arm->checkMotionDone(&done);
+}
+
+
+bool YarpRobot::setGazeTrajTime(double neck, double eyes) {
+    bool ok = true;
+    ok &= _gaze->setNeckTrajTime(neck);
+    ok &= _gaze->setEyesTrajTime(eyes);
+    return ok;
+}
+
+
+bool YarpRobot::lookAtAbsAngles(const yarp::sig::Vector& ang) {
+    return _gaze->lookAtAbsAngles(ang);
+}
+
+
+bool YarpRobot::sendFace(const FaceFrame& frame) {
+
+    //-- Strict writes keep every part, in order, without waiting on a reply.
+    for (const yarp::os::Bottle& bot : frame) {
+        yarp::os::Bottle& out = _expr_port.prepare();
+        out = bot;
+        _expr_port.writeStrict();
+    }
+
+    return true;
+}
@@ -0,0 +1,102 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef BOARD_LAYOUT_HPP
+#define BOARD_LAYOUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+/* ================================================================================
+**  Geometry of the peg labels and FROM/TO selectors under the board. Every
+**  line is built once for the peg count, so drawing a selection state is a
+**  table lookup.
+** ================================================================================ */
+class BoardLayout {
+
+    public:
+    //-- Pegs are picked with the keys '1' to '9'.
+    static const int MAX_PEGS = 9;
+
+    //-- Columns before the first peg cell on the game server's board.
+    static const int BOARD_MARGIN = 2;
+
+
+    private:
+    /* ============================================================================
+    **  Internal members for the layout.
+    ** ============================================================================ */
+    int _num_pegs;
+    std::vector<int> _centers;           // column of each peg's center.
+
+    std::string _labels;                 // shifted "[1]  [2] ..." line.
+    std::vector<std::string> _selectors; // by state, see index().
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    BoardLayout();
+
+
+    /* ============================================================================
+    **  Compute the layout.
+    **
+    ** @param num_pegs     : number of pegs on the board.
+    ** @param board_width  : columns of the board, excluding its margin.
+    ** @param window_width : columns of the window, to center [ENTER] in.
+    ** @param right_shift  : columns everything is shifted right by.
+    **
+    ** @return false if the pegs don't fit or can't all be picked by key.
+    ** ============================================================================ */
+    bool build(int num_pegs, int board_width, int window_width, int right_shift);
+
+
+    /* ============================================================================
+    **  Get the number of pegs the layout was built for.
+    ** ============================================================================ */
+    int numPegs() const;
+
+
+    /* ============================================================================
+    **  Get the peg label line, ending in a newline.
+    ** ============================================================================ */
+    const std::string& labels() const;
+
+
+    /* ============================================================================
+    **  Get the selector lines for a selection, three lines in all.
+    **
+    ** @param from : selected from peg, 1 based, -1 for none.
+    ** @param to   : selected to peg, 1 based, -1 for none.
+    ** ============================================================================ */
+    const std::string& selector(int from, int to) const;
+
+
+    private:
+    /* ============================================================================
+    **  Index of a selection state into _selectors.
+    ** ============================================================================ */
+    std::size_t index(int from, int to) const;
+
+
+    /* ============================================================================
+    **  Write text into a line so that it starts at the given column.
+    ** ============================================================================ */
+    static void place(std::string& line, int column, const std::string& text);
+
+};
+
+#endif /* BOARD_LAYOUT_HPP */
@@ -65,9 +65,18 @@ class CsvLogger {
 
     /* ============================================================================
     **  Log an entry into the output stream.
+    **
+    ** @param code : the board before the move packed as in HanoiModel::encode
+    **     (empty if it couldn't be read).
+    ** @param from_time, to_time, enter_time : when the from and to pegs were
+    **     selected and the move confirmed, in seconds since the game started
+    **     (-1 if not part of a move).
+    ** @param hint_latency : seconds from sending the hint clip to its first frame
+    **     on screen (-1 if the player has not reported it).
     ** ============================================================================ */
     void log(double int_time, std::string user_id, std::string channel, std::string hint_id, 
-             std::string hash, std::string distance, int move_number, int from, int to);
+             std::string hash, std::string code, std::string distance, int move_number, int from, int to,
+             double from_time, double to_time, double enter_time, double hint_latency);
 
 };
 
@@ -18,14 +18,18 @@
 //#include <map>
 //#include <memory>
 
+#include <fstream>
 #include <iostream>
+#include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <yarp/os/Network.h>
 
 #include <yarp/os/Bottle.h>
+#include <yarp/os/BufferedPort.h>
 #include <yarp/os/LogStream.h>
 #include <yarp/os/RFModule.h>
 #include <yarp/os/RpcClient.h>
@@ -35,10 +39,17 @@
 
 #include <stateMachine.hpp>
 #include <csvLogger.hpp>
+#include <boardLayout.hpp>
+#include <keyInput.hpp>
+#include <latencyStats.hpp>
+#include <hanoiModel.hpp>
 
 
 class EmbodiedSocialInterface : public yarp::os::RFModule {
 
+    //-- The benchmarks drive the private draw and parse paths directly.
+    friend class EmbodiedSocialInterfaceBench;
+
     private:
     /* ============================================================================
     **  Yarp RPC client for sending commands and receiving responses.
@@ -56,6 +67,9 @@ class EmbodiedSocialInterface : public yarp::os::RFModule {
     int    _max_steps_per;
 
     double _time_between;
+    bool   _prefetch;
+    bool   _local_model;
+    bool   _board_code;
 
     int _max_tower_height;
     int _window_height;
@@ -69,27 +83,73 @@ class EmbodiedSocialInterface : public yarp::os::RFModule {
     yarp::os::Port _media_port;
     yarp::os::Port _web_port;
 
+    //-- Load and first frame times reported back by the media player.
+    yarp::os::BufferedPort<yarp::os::Bottle> _media_status;
+
 
     /* ============================================================================
     **  Encapsulated objects.
     ** ============================================================================ */
     StateMachine _machine;
     CsvLogger    _logger;
+    BoardLayout  _layout;
+    KeyInput     _input;
 
 
     /* ============================================================================
     **  Control variables for the interface.
     ** ============================================================================ */
-    std::vector<std::string> showable_rows;
+    std::string _board;                     // last board reply, reused.
+    std::vector<std::string_view> _rows;    // lines of _board, without '\n'.
+    bool _board_changed;                    // _board differs from the one drawn.
     int selected_from, selected_to;
+    double _from_time, _to_time;            // KeyInput stamps of the selections.
     
     int _move_count;
     int _waiting_count;
     bool _game_complete;
     bool _current_hint_sent;
 
-    double _last_execution;
+    int _drawn_from, _drawn_to;             // selections on screen.
+    int _drawn_moves;                       // move count on screen.
+    bool _drawn_complete;                   // win banner on screen.
+
+    double _last_execution;                 // KeyInput stamp of the last move.
     double _start_time;
+    double _start_stamp;                    // _start_time on the KeyInput clock.
+
+
+    /* ============================================================================
+    **  Media latency of the hint (``_in``) clips, from sending one to the
+    **  player loading it and putting its first frame up. Both stamp with
+    **  CLOCK_MONOTONIC, so this is only meaningful with the player on the
+    **  same host.
+    ** ============================================================================ */
+    int    _media_seq;                      // sequence number of the last clip sent.
+    int    _hint_seq;                       // of the last ``_in`` clip sent.
+    std::set<int> _hint_seqs;               // ``_in`` clips not reported yet.
+    double _hint_latency;                   // of that clip, -1 until reported.
+    LatencyStats _load_latency;
+    LatencyStats _present_latency;
+
+
+    /* ============================================================================
+    **  Local copy of the game, so illegal moves never reach the server and
+    **  legal ones are drawn before it answers.
+    ** ============================================================================ */
+    HanoiModel _model;                      // from the last board shown.
+    HanoiModel _expected;                   // after the last move drawn ahead.
+    bool _expect_pending;                   // _expected not yet checked against the server.
+    int  _local_rejects;                    // moves turned away without the server.
+    std::vector<std::string> _disagreements;
+    std::ofstream _disagree_log;            // <user>_disagreements.log, opened on the first.
+
+    //-- The board shown, packed. Once _model knows the board's look the
+    //-- server is asked for just this, and the board is drawn from it.
+    std::uint64_t _code;
+    bool          _has_code;
+    HanoiModel    _decoded;                 // reused to draw a code.
+    std::string   _coded;                   // board drawn from the last code.
 
 
     public:
@@ -151,15 +211,69 @@ class EmbodiedSocialInterface : public yarp::os::RFModule {
 
 
     /* ============================================================================
-    **  
+    **  Send a clip to the media player as ``(<msg> <seq> <stamp>)``, the stamp
+    **  being the KeyInput clock at send time.
+    **
+    ** @return sequence number of the clip.
     ** ============================================================================ */
-    void keyPressed(int key_num);
+    int sendMedia(const std::string msg);
 
 
     /* ============================================================================
-    **  
+    **  Collect the ``(<seq> <sent> <loaded> <presented>)`` reports of the
+    **  ``_in`` clips from the media player into the latency stats. sent is
+    **  on our clock, loaded and presented on the player's; same host only.
+    ** ============================================================================ */
+    void readMediaStatus();
+
+
+    /* ============================================================================
+    **  Tell the media player which clips are likely next as
+    **  ``prefetch (<clip> ...)``, so it can open them ahead of time.
+    ** ============================================================================ */
+    void sendPrefetch(const std::vector<std::string>& clips);
+
+
+    /* ============================================================================
+    **  The ``_out`` clips that can follow the current hint; expressions have
+    **  one for a correct move and one for a wrong one.
     ** ============================================================================ */
-    void parseShowable(std::string str);
+    std::vector<std::string> outClips();
+
+
+    /* ============================================================================
+    **  Select or deselect a peg, keeping the stamp of the key that did it.
+    ** ============================================================================ */
+    void keyPressed(int key_num, double stamp);
+
+
+    /* ============================================================================
+    **  Note a move the local model and the server saw differently. Written
+    **  to a log next to the csv as it happens, and kept for close, since the
+    **  screen belongs to ncurses until then.
+    ** ============================================================================ */
+    void disagree(const std::string& what);
+
+
+    /* ============================================================================
+    **  Check the board the server shows against the one drawn ahead of it.
+    ** ============================================================================ */
+    void checkModel();
+
+
+    /* ============================================================================
+    **  Get the current board from the game server and parse it. Asks for the
+    **  ``code`` when it can draw the board itself, for the full ``show`` when
+    **  it can't or the code doesn't fit the last board seen.
+    ** ============================================================================ */
+    void queryBoard(yarp::os::Bottle& command, yarp::os::Bottle& response);
+
+
+    /* ============================================================================
+    **  Index the rows of a board reply. Skipped if the reply is the same as
+    **  the last one, since the rows still point into it.
+    ** ============================================================================ */
+    void parseShowable(const std::string& str);
 
 
     /* ============================================================================
@@ -168,6 +282,12 @@ class EmbodiedSocialInterface : public yarp::os::RFModule {
     void drawInterface();
 
 
+    /* ============================================================================
+    **  Write a board row to the screen, shifted right, straight from _board.
+    ** ============================================================================ */
+    void drawRow(const std::string& shift, std::string_view row);
+
+
     /* ============================================================================
     **  
     ** ============================================================================ */
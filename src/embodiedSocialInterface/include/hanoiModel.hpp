@@ -0,0 +1,148 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef HANOI_MODEL_HPP
+#define HANOI_MODEL_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/* ================================================================================
+**  Local copy of the game, read off a board the server showed. It knows the
+**  rules, so illegal moves are turned away without a round trip, and it can
+**  draw the board a legal move leads to before the server confirms it.
+**
+**  The board is a header row, the peg tops, one row per disk level and the
+**  base. Disks are told apart by width; whatever the server draws them with is
+**  kept and drawn back the same way.
+**
+**  A position also packs into a 64 bit code, one base ``pegs`` digit per disk
+**  holding its peg, the smallest disk the lowest digit. Once a board has been
+**  seen, the code is all it takes to draw the next one.
+** ================================================================================ */
+class HanoiModel {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the model.
+    ** ============================================================================ */
+    bool _valid;
+
+    std::vector<std::vector<int>> _pegs; // disks bottom to top, 0 the smallest.
+    std::vector<int> _centers;           // column of each peg's '|'.
+
+    std::vector<std::string> _glyphs;    // how each disk is drawn.
+    std::vector<int> _offsets;           // columns of a glyph left of its center.
+
+    std::string _header, _top, _base;    // rows that never change.
+    int  _levels;                        // disk rows on the board.
+    bool _newline;                       // board ends in '\n'.
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    HanoiModel();
+
+
+    /* ============================================================================
+    **  Read the game off the rows of a board.
+    **
+    ** @param rows : lines of the board, without '\n'.
+    ** @param newline : whether the board ended in '\n'.
+    **
+    ** @return false, and the model invalid, if the board can't be read or
+    **         isn't a reachable position.
+    ** ============================================================================ */
+    bool parse(const std::vector<std::string_view>& rows, bool newline);
+
+
+    /* ============================================================================
+    **  Accessors.
+    ** ============================================================================ */
+    bool valid() const;
+    int numPegs() const;
+    int numDisks() const;
+
+
+    /* ============================================================================
+    **  Check a move, pegs 0 based. Always false on an invalid model.
+    ** ============================================================================ */
+    bool legal(int from, int to) const;
+
+
+    /* ============================================================================
+    **  Make a move, pegs 0 based.
+    **
+    ** @return false, and nothing moved, if the move isn't legal.
+    ** ============================================================================ */
+    bool apply(int from, int to);
+
+
+    /* ============================================================================
+    **  Whether two models hold the same position.
+    ** ============================================================================ */
+    bool matches(const HanoiModel& other) const;
+
+
+    /* ============================================================================
+    **  Most disks a code can hold for a number of pegs, e.g. 40 for 3.
+    ** ============================================================================ */
+    static int maxDisks(int num_pegs);
+
+
+    /* ============================================================================
+    **  Pack the position into a code.
+    **
+    ** @return false on an invalid model or one with too many disks.
+    ** ============================================================================ */
+    bool encode(std::uint64_t& code) const;
+
+
+    /* ============================================================================
+    **  Set the position from a code, keeping the board's look.
+    **
+    ** @return false, and nothing changed, on an invalid model or a code that
+    **         isn't for this many pegs and disks.
+    ** ============================================================================ */
+    bool decode(std::uint64_t code);
+
+
+    /* ============================================================================
+    **  The position as ``(2 1 0) () ()``, disks bottom to top, for the logs.
+    ** ============================================================================ */
+    std::string toString() const;
+
+
+    /* ============================================================================
+    **  Draw the position the way the server would.
+    **
+    ** @param board : replaced with the board text.
+    ** ============================================================================ */
+    void render(std::string& board) const;
+
+
+    private:
+    /* ============================================================================
+    **  Find the disk on a peg in a row.
+    **
+    ** @return false if the peg is bare in that row.
+    ** ============================================================================ */
+    bool readDisk(std::string_view row, int peg, std::string& glyph, int& offset) const;
+
+};
+
+#endif /* HANOI_MODEL_HPP */
@@ -0,0 +1,128 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef KEY_INPUT_HPP
+#define KEY_INPUT_HPP
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+
+/* ================================================================================
+**  A key read from the terminal, stamped when it arrived.
+** ================================================================================ */
+struct KeyPress {
+    int key;
+    double stamp; // seconds on the monotonic clock (KeyInput::now()).
+};
+
+
+/* ================================================================================
+**  Reads the terminal on its own thread so that keypresses are stamped as they
+**  arrive rather than when the module next ticks. Keys are handed over through
+**  a single producer/single consumer ring, so neither side ever blocks.
+** ================================================================================ */
+class KeyInput {
+
+    public:
+    static constexpr std::size_t CAPACITY = 64;
+
+
+    private:
+    /* ============================================================================
+    **  Ring shared between the reader thread (push) and the tick (pop).
+    ** ============================================================================ */
+    std::array<KeyPress, CAPACITY> _ring;
+    std::atomic<std::size_t> _head; // next slot to pop, written by the tick.
+    std::atomic<std::size_t> _tail; // next slot to push, written by the reader.
+    std::atomic<std::size_t> _dropped;
+
+    int _fd;
+    std::atomic<bool> _running;
+    std::thread _reader;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    KeyInput();
+
+
+    /* ============================================================================
+    **  Destructor.
+    ** ============================================================================ */
+    ~KeyInput();
+
+
+    /* ============================================================================
+    **  Start reading keys from a terminal. The terminal should already be in
+    **  cbreak mode so keys are not held back until a newline.
+    **
+    ** @param fd  file descriptor of the terminal.
+    **
+    ** @return success of starting the reader thread.
+    ** ============================================================================ */
+    bool start(int fd = STDIN_FILENO);
+
+
+    /* ============================================================================
+    **  Stop and join the reader thread.
+    ** ============================================================================ */
+    void stop();
+
+
+    /* ============================================================================
+    **  Take the oldest key, if there is one. Only call from one thread.
+    ** ============================================================================ */
+    bool pop(KeyPress& key);
+
+
+    /* ============================================================================
+    **  Throw away every queued key.
+    ** ============================================================================ */
+    void clear();
+
+
+    /* ============================================================================
+    **  Number of keys lost because the ring was full.
+    ** ============================================================================ */
+    std::size_t dropped() const;
+
+
+    /* ============================================================================
+    **  Seconds on the monotonic clock the keys are stamped with.
+    ** ============================================================================ */
+    static double now();
+
+
+    private:
+    /* ============================================================================
+    **  Reader thread loop.
+    ** ============================================================================ */
+    void readLoop();
+
+
+    /* ============================================================================
+    **  Add a key to the ring, dropping it if the tick has fallen behind.
+    ** ============================================================================ */
+    void push(const KeyPress& key);
+
+};
+
+#endif /* KEY_INPUT_HPP */
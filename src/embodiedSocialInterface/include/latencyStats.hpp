@@ -0,0 +1,74 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef LATENCY_STATS_HPP
+#define LATENCY_STATS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+
+
+/* ================================================================================
+**  Every latency sample of a session, for percentiles on demand. A game is a
+**  few hundred moves, so keeping them all is cheaper than being clever.
+** ================================================================================ */
+class LatencyStats {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the stats.
+    ** ============================================================================ */
+    std::vector<double> _samples;
+    double _max;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    LatencyStats();
+
+
+    /* ============================================================================
+    **  Forget every sample.
+    ** ============================================================================ */
+    void clear();
+
+
+    /* ============================================================================
+    **  Add a latency (seconds).
+    ** ============================================================================ */
+    void add(double latency);
+
+
+    /* ============================================================================
+    **  Accessors, all in seconds.
+    **
+    ** @param q : quantile in [0, 1], e.g. 0.99.
+    ** ============================================================================ */
+    std::size_t count() const;
+    double max() const;
+    double percentile(double q) const;
+
+
+    /* ============================================================================
+    **  Append the stats to a reply as ``(<name> n <n> p50 <s> p90 <s> p99 <s> max <s>)``.
+    ** ============================================================================ */
+    void addTo(yarp::os::Bottle& reply, const std::string name) const;
+
+};
+
+#endif /* LATENCY_STATS_HPP */
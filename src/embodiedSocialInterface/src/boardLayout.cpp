@@ -0,0 +1,110 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <boardLayout.hpp>
+
+
+BoardLayout::BoardLayout() :
+    _num_pegs(0) {
+}
+
+
+bool BoardLayout::build(int num_pegs, int board_width, int window_width, int right_shift) {
+
+    int cell = (num_pegs > 0 ? board_width / num_pegs : 0);
+    if (num_pegs < 2 || num_pegs > MAX_PEGS || cell < 5) {
+        return false;
+    }
+
+    _num_pegs = num_pegs;
+    std::string shift(right_shift, ' ');
+
+    //-- Each peg sits in the middle of its cell.
+    _centers.clear();
+    for (int peg = 0; peg < _num_pegs; ++peg) {
+        _centers.push_back(BOARD_MARGIN + cell * peg + cell / 2);
+    }
+
+    //-- Selector text is five wide, centered on the peg. Lines run to the
+    //-- end of the last peg's selector.
+    int line_width = _centers.back() + 3;
+
+    //-- ROW SECTION 4: disk selections.
+    _labels = std::string(line_width, ' ');
+    for (int peg = 0; peg < _num_pegs; ++peg) {
+        place(_labels, _centers[peg] - 1, "[" + std::to_string(peg + 1) + "]");
+    }
+    _labels = shift + _labels.substr(0, _labels.find_last_not_of(' ') + 1) + "\n";
+
+    std::string enter_buffer = "[ENTER]";
+    std::string enter_line   = shift + std::string((window_width - enter_buffer.length() + 1) / 2, ' ') + enter_buffer + "\n";
+
+    //-- One entry per (from, to), with to = 0 for only a from selected,
+    //-- and entry 0 for nothing selected.
+    _selectors.assign((_num_pegs + 1) * (_num_pegs + 1), "\n\n\n");
+
+    for (int from = 1; from <= _num_pegs; ++from) {
+
+        //-- Just a from.
+        int column = _centers[from - 1] - 2;
+        _selectors[index(from, -1)] = shift + std::string(column, ' ') + "^^^^^" + "\n"
+                                    + shift + std::string(column, ' ') + "FROM " + "\n\n";
+
+        //-- From and to.
+        for (int to = 1; to <= _num_pegs; ++to) {
+
+            if (to == from) continue;
+
+            std::string carets(line_width, ' ');
+            std::string words(line_width,  ' ');
+            place(carets, _centers[from - 1] - 2, "^^^^^");
+            place(carets, _centers[to - 1]   - 2, "^^^^^");
+            place(words,  _centers[from - 1] - 2, "FROM ");
+            place(words,  _centers[to - 1]   - 2, " TO  ");
+
+            _selectors[index(from, to)] = shift + carets + "\n" + shift + words + "\n" + enter_line;
+        }
+    }
+
+    return true;
+}
+
+
+int BoardLayout::numPegs() const {
+    return _num_pegs;
+}
+
+
+const std::string& BoardLayout::labels() const {
+    return _labels;
+}
+
+
+const std::string& BoardLayout::selector(int from, int to) const {
+    return _selectors[index(from, to)];
+}
+
+
+std::size_t BoardLayout::index(int from, int to) const {
+
+    //-- Anything out of range draws as nothing selected.
+    if (from < 1 || from > _num_pegs) return 0;
+    if (to   < 1 || to   > _num_pegs) to = 0;
+
+    return from * (_num_pegs + 1) + to;
+}
+
+
+void BoardLayout::place(std::string& line, int column, const std::string& text) {
+    line.replace(column, text.size(), text);
+    return;
+}
@@ -52,10 +52,15 @@ bool CsvLogger::openLogger(std::string fname) {
             << "channel"  << ","
             << "hint_id"  << ","
             << "hash"     << ","
+            << "code"     << ","
             << "dist"     << ","
             << "move"     << ","
             << "from"     << ","
-            << "to"            
+            << "to"       << ","
+            << "from_time"<< ","
+            << "to_time"  << ","
+            << "enter_time" << ","
+            << "hint_latency"
             << std::endl;
 
     return true;
@@ -75,7 +80,8 @@ bool CsvLogger::closeLogger() {
 
 
 void CsvLogger::log(double int_time, std::string user_id, std::string channel, std::string hint_id,  
-    std::string hash, std::string distance, int move_number, int from, int to) {
+    std::string hash, std::string code, std::string distance, int move_number, int from, int to,
+    double from_time, double to_time, double enter_time, double hint_latency) {
 
     //-- "sys_time" 
     std::time_t t = std::time(nullptr);
@@ -84,11 +90,17 @@ void CsvLogger::log(double int_time, std::string user_id, std::string channel, s
     //-- "int_time"
     _output << std::setprecision(10) << int_time << ",";
 
-    //-- "user_id", "channel", "hint_id", "hash",
-    _output << user_id << "," << channel << "," << hint_id << "," << hash << ",";
+    //-- "user_id", "channel", "hint_id", "hash", "code"
+    _output << user_id << "," << channel << "," << hint_id << "," << hash << "," << code << ",";
 
     //-- "dist", "move", "from", "to"
-    _output << distance << "," << move_number << "," << from << "," << to;
+    _output << distance << "," << move_number << "," << from << "," << to << ",";
+
+    //-- "from_time", "to_time", "enter_time"
+    _output << from_time << "," << to_time << "," << enter_time << ",";
+
+    //-- "hint_latency"
+    _output << hint_latency;
     
     //-- Move to the next line.
     _output << std::endl;
@@ -41,6 +41,7 @@ bool EmbodiedSocialInterface::configure(yarp::os::ResourceFinder &rf) {
     bool ok = true;
     ok &= _media_port.open( this->getName() + "/media:o" );
     ok &= _web_port.open(   this->getName() + "/web:o"   );
+    ok &= _media_status.open( this->getName() + "/media:i" );
     if (!ok) {
         yInfo("%s: Something went wrong opening the auxiliary ports!", this->getName().c_str());
         return false;
@@ -82,12 +83,32 @@ bool EmbodiedSocialInterface::configure(yarp::os::ResourceFinder &rf) {
     _time_between = rf.check("seconds", yarp::os::Value(5.0), " (double)").asFloat64();
 
 
+    //-- Send the media player the likely next clips ahead of time.
+    _prefetch = rf.check("prefetch", yarp::os::Value(true), "prefetch clips (bool)").asBool();
+
+
+    //-- Check moves against a local copy of the game before the server.
+    _local_model = rf.check("localModel", yarp::os::Value(true), "check moves locally (bool)").asBool();
+
+    //-- Get the board from the game server as a code after the first one.
+    //-- Needs the local model to draw it.
+    _board_code = rf.check("boardCode", yarp::os::Value(true), "board as a code (bool)").asBool() && _local_model;
+
+
     //-- Set some interface appearance vars.
     _max_tower_height = rf.check("maxTower", yarp::os::Value(10), " (int)").asInt32();
     _window_height    = rf.check("height",   yarp::os::Value(13), " (int)").asInt32();
     _window_width     = rf.check("width",    yarp::os::Value(36), " (int)").asInt32();
     _right_shift      = rf.check("rshift",   yarp::os::Value(0),  " (int)").asInt32();
 
+    //-- Lay out the peg selectors once for the board.
+    int num_pegs    = rf.check("pegs",       yarp::os::Value(3),  "number of pegs (int)").asInt32();
+    int board_width = rf.check("boardWidth", yarp::os::Value(33), "board columns (int)").asInt32();
+    if (!_layout.build(num_pegs, board_width, _window_width, _right_shift)) {
+        yInfo("%s: Unable to lay out %d pegs in %d columns!!", this->getName().c_str(), num_pegs, board_width);
+        return false;
+    }
+
 
     //-- Set the URL to the end of game survey.
     _end_survey = rf.check("survey", yarp::os::Value("https://kothiga.github.io/"), "survey url (string)").asString();
@@ -96,6 +117,8 @@ bool EmbodiedSocialInterface::configure(yarp::os::ResourceFinder &rf) {
     //-- Init the from and to as unselected.
     selected_from = -1;
     selected_to   = -1;
+    _from_time    = -1.0;
+    _to_time      = -1.0;
 
 
     //-- Init some interface logic vars.
@@ -103,16 +126,36 @@ bool EmbodiedSocialInterface::configure(yarp::os::ResourceFinder &rf) {
     _waiting_count     =  0;
     _game_complete     = false;
     _current_hint_sent = false;
-    _last_execution    = yarp::os::Time::now();
+    _board_changed     = true;
+    _drawn_moves       = -1;
+    _last_execution    = KeyInput::now();
+    _start_time        = yarp::os::Time::now();
+    _start_stamp       = KeyInput::now();
+
+    _media_seq         =  0;
+    _hint_seq          = -1;
+    _hint_latency      = -1.0;
+
+    _expect_pending    = false;
+    _local_rejects     =  0;
+    _code              =  0;
+    _has_code          = false;
     
 
     //-- Init the ncurses window.
     setlocale(LC_ALL, "");
     initscr();
+    cbreak();
     noecho();
     keypad(stdscr, TRUE);
     refresh();
 
+    //-- Keys are read and stamped on their own thread from here on.
+    if (!_input.start()) {
+        yInfo("%s: Unable to start the key input thread!!", this->getName().c_str());
+        return false;
+    }
+
     return true;
 }
 
@@ -125,6 +168,7 @@ bool EmbodiedSocialInterface::interruptModule() {
 
     _media_port.interrupt();
     _web_port.interrupt();
+    _media_status.interrupt();
 
     return true;
 }
@@ -138,9 +182,16 @@ bool EmbodiedSocialInterface::close() {
 
     _media_port.close();
     _web_port.close();
+    _media_status.close();
+
+    //-- Stop reading keys before handing the terminal back.
+    _input.stop();
 
-    //-- Close the file stream.
+    //-- Close the file streams.
     _logger.closeLogger();
+    if (_disagree_log.is_open()) {
+        _disagree_log.close();
+    }
 
     //-- End the ncurses window.
     endwin();
@@ -148,13 +199,27 @@ bool EmbodiedSocialInterface::close() {
     //-- Give a little end of game message.
     yInfo() << "You made it to the end in" << _move_count << "moves!!";
 
+    if (_present_latency.count() != 0) {
+        yInfo("%s: hint latency p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms over %zu clips", 
+            this->getName().c_str(), _present_latency.percentile(0.50)*1e3, _present_latency.percentile(0.90)*1e3, 
+            _present_latency.percentile(0.99)*1e3, _present_latency.max()*1e3, _present_latency.count());
+    }
+
+    if (_local_model) {
+        yInfo("%s: %d illegal moves turned away locally, %zu disagreements with the game server", 
+            this->getName().c_str(), _local_rejects, _disagreements.size());
+        for (const auto& what : _disagreements) {
+            yWarning("%s: %s", this->getName().c_str(), what.c_str());
+        }
+    }
+
     return true;
 }
 
 
 bool EmbodiedSocialInterface::respond(const yarp::os::Bottle &cmd, yarp::os::Bottle &reply) {
     
-    std::string helpMessage = std::string(getName().c_str()) + " commands are: \n" + "help \n" + "quit \n";
+    std::string helpMessage = std::string(getName().c_str()) + " commands are: \n" + "help \n" + "latency \n" + "quit \n";
     reply.clear();
 
     if (cmd.get(0).asString() == "quit") {
@@ -163,6 +228,10 @@ bool EmbodiedSocialInterface::respond(const yarp::os::Bottle &cmd, yarp::os::Bot
     } else if (cmd.get(0).asString() == "help") {
         yInfo() << helpMessage;
         reply.addString(helpMessage);
+    } else if (cmd.get(0).asString() == "latency") {
+        //-- Seconds from sending a clip to the player loading/showing it.
+        _load_latency.addTo(reply, "load");
+        _present_latency.addTo(reply, "present");
     }
 
     return true;
@@ -183,23 +252,29 @@ bool EmbodiedSocialInterface::updateModule() {
         drawWaiting();
         yarp::os::Time::delay(1.0);
         
-        sendMessage(_media_port, "none");
+        sendMedia("none");
         _current_hint_sent = false;
 
-        _last_execution = yarp::os::Time::now();
+        //-- Keys pressed before the game started don't count.
+        _input.clear();
+
+        _last_execution = KeyInput::now();
         _start_time     = yarp::os::Time::now();
+        _start_stamp    = KeyInput::now();
 
         return true;
     }
     
+    //-- Pick up any latency reports from the media player.
+    readMediaStatus();
+
     //-- Init some bottles for communication.
     yarp::os::Bottle cmd, rsp;
 
-    //-- Query the game server for the current board state.
-    std::string board_status = communicate("show", cmd, rsp);
-
-    //-- Parse it up into neat rows.
-    parseShowable(board_status);
+    //-- Query the game server for the current board state,
+    //-- parsed up into neat rows.
+    queryBoard(cmd, rsp);
+    checkModel();
 
     //-- Draw the interface.
     drawInterface();
@@ -214,40 +289,47 @@ bool EmbodiedSocialInterface::updateModule() {
         
         std::string media_msg = _media_path + "/" + _machine.getStateHint("in") + ".mp4";
         
-        sendMessage(_media_port, media_msg);
+        _hint_seq     = sendMedia(media_msg);
+        _hint_latency = -1.0;
+        _hint_seqs.insert(_hint_seq);
+
+        //-- The out clip is known from here on.
+        sendPrefetch(outClips());
         
         _current_hint_sent = true;
     }
 
 
-    //-- Wait for key input.
-    int key_press = getch();
+    //-- Go through the keys pressed since the last tick, up to the
+    //-- first move. Anything after it waits for the next tick.
+    KeyPress key;
     bool execute_move = false;
-
-    //-- See if one of `our` keys were pressed.
-    switch (key_press) {
-
-        case '1':
-            keyPressed(1);
-            break;
-
-        case '2':
-            keyPressed(2);
-            break;
-
-        case '3':
-            keyPressed(3);
-            break;
-
-        case 10: // [ENTER]
-            if (selected_from != -1 && selected_to != -1) {
-                execute_move = true;
-            }
-            break;
-        
-        // Nope.
-        default:
-            break;
+    double enter_time = -1.0;
+
+    while (!execute_move && _input.pop(key)) {
+
+        //-- See if one of `our` keys were pressed.
+        switch (key.key) {
+
+            case '1': case '2': case '3':
+            case '4': case '5': case '6':
+            case '7': case '8': case '9':
+                if (key.key - '0' <= _layout.numPegs()) {
+                    keyPressed(key.key - '0', key.stamp);
+                }
+                break;
+
+            case 10: case 13: // [ENTER]
+                if (selected_from != -1 && selected_to != -1) {
+                    execute_move = true;
+                    enter_time   = key.stamp;
+                }
+                break;
+            
+            // Nope.
+            default:
+                break;
+        }
     }
 
     
@@ -255,12 +337,33 @@ bool EmbodiedSocialInterface::updateModule() {
     if (execute_move) {
 
         //-- If this move was too fast, don't let it go through.
-        if ((yarp::os::Time::now() - _last_execution) < _time_between) {
-            //std::cout << yarp::os::Time::now() - _last_execution << " no" << std::endl;
+        if ((enter_time - _last_execution) < _time_between) {
+            //std::cout << enter_time - _last_execution << " no" << std::endl;
             return true;
         }
 
 
+        //-- Illegal moves are turned away here, without asking the server.
+        //-- Legal ones are drawn right away while the server confirms.
+        bool drawn_ahead = false;
+        std::string position = _model.toString();
+        std::string game_code = (_has_code ? std::to_string(_code) : "");
+        if (_local_model && _model.valid() && _model.numPegs() == _layout.numPegs()) {
+
+            if (!_model.legal(selected_from-1, selected_to-1)) {
+                _local_rejects++;
+                return true;
+            }
+
+            _expected = _model;
+            _expected.apply(selected_from-1, selected_to-1);
+            _expected.render(_coded);
+            parseShowable(_coded);
+            drawInterface();
+            drawn_ahead = true;
+        }
+
+
         //-- Format the move.
         std::string game_move = std::to_string(selected_from-1) + " " + std::to_string(selected_to-1);
         std::string move = "move " + game_move;
@@ -278,9 +381,19 @@ bool EmbodiedSocialInterface::updateModule() {
 
         //-- If the move was not good, go to next update step.
         if (move_status == "0") { // "1" and "2" are accepted moves.
+
+            //-- Put the server's board back up over the one drawn ahead.
+            if (drawn_ahead) {
+                disagree("move " + game_move + " from " + position + " refused by the server");
+                queryBoard(cmd, rsp);
+                drawInterface();
+            }
             return true;
         }
 
+        //-- Checked against the next board the server shows.
+        _expect_pending = drawn_ahead;
+
         
         // Log the data for this move.
         _logger.log(
@@ -289,40 +402,52 @@ bool EmbodiedSocialInterface::updateModule() {
             /*channel    =*/ _machine.getCurrentState(),
             /*hint_id    =*/ game_hint,
             /*hash       =*/ game_hash,
+            /*code       =*/ game_code,
             /*distance   =*/ game_dist,
             /*move_number=*/ _move_count,
             /*from       =*/ selected_from-1,
-            /*to         =*/ selected_to-1
+            /*to         =*/ selected_to-1,
+            /*from_time  =*/ _from_time - _start_stamp,
+            /*to_time    =*/ _to_time   - _start_stamp,
+            /*enter_time =*/ enter_time - _start_stamp,
+            /*hint_lat   =*/ _hint_latency
         );
 
 
         //-- Reset the selected moves and increment counter.
         selected_from = -1;
         selected_to   = -1;
+        _from_time    = -1.0;
+        _to_time      = -1.0;
         _move_count++;
 
 
         //-- Retract the hint back to the home state.
-        std::string media_msg = _media_path + "/" + _machine.getStateHint("out") + ".mp4";
-        
-        //-- Do something slightly different for expressions.
-        if (_machine.getCurrentState() == "icub-expression") {
-            media_msg = _media_path + "/" + _machine.getCurrentState() + "_";
-            media_msg += (game_move == game_hint ? "correct" : "wrong");
-            media_msg += "_out.mp4";
+        //-- Expressions have a correct and a wrong clip (see outClips).
+        std::vector<std::string> out_clips = outClips();
+        std::string media_msg = out_clips[0];
+        if (out_clips.size() > 1 && game_move != game_hint) {
+            media_msg = out_clips[1];
         }
         
-        sendMessage(_media_port, media_msg);
+        sendMedia(media_msg);
         
         _current_hint_sent = false;
 
 
         //-- Set the previous execution time.
-        _last_execution = yarp::os::Time::now();
+        _last_execution = KeyInput::now();
         
         //-- Step the state machine.
         _machine.step();
 
+        //-- The next in clip is known as soon as the new board is. Hint
+        //-- early so the player can open it while the out clip plays.
+        if (move_status != "2" && _prefetch && _media_port.getOutputCount() != 0) {
+            _machine.setCurrentHint(communicate("hint", cmd, rsp));
+            sendPrefetch({ _media_path + "/" + _machine.getStateHint("in") + ".mp4" });
+        }
+
         //-- Allow a bit of time for the media port to read in
         //-- the previous message before looping back around.
         yarp::os::Time::delay(0.2);
@@ -334,11 +459,9 @@ bool EmbodiedSocialInterface::updateModule() {
             //-- Mark the game as completed.
             _game_complete = true;
 
-            //-- Get the final board state.
-            board_status = communicate("show", cmd, rsp);
-
-            //-- Parse the final board status and show it.
-            parseShowable(board_status);
+            //-- Get the final board state, parse it and show it.
+            queryBoard(cmd, rsp);
+            checkModel();
             drawInterface();
 
             //-- Get the final board state information.
@@ -352,14 +475,19 @@ bool EmbodiedSocialInterface::updateModule() {
                 /*channel    =*/ "",
                 /*hint_id    =*/ "",
                 /*hash       =*/ game_hash,
+                /*code       =*/ (_has_code ? std::to_string(_code) : ""),
                 /*distance   =*/ game_dist,
                 /*move_number=*/ _move_count,
                 /*from       =*/ selected_from, // -1
-                /*to         =*/ selected_to    // -1
+                /*to         =*/ selected_to,   // -1
+                /*from_time  =*/ -1.0,
+                /*to_time    =*/ -1.0,
+                /*enter_time =*/ -1.0,
+                /*hint_lat   =*/ -1.0
             );
 
             //-- Send a celebration video for completing the game.
-            sendMessage(_media_port, _media_path + "/celebrate.mp4");
+            sendMedia(_media_path + "/celebrate.mp4");
 
             //-- Wait for a few seconds before beginning to wrap up.
             yarp::os::Time::delay(8.0);
@@ -417,18 +545,93 @@ void EmbodiedSocialInterface::sendMessage(yarp::os::Port& port, const std::strin
 }
 
 
-void EmbodiedSocialInterface::keyPressed(int key_num) {
+int EmbodiedSocialInterface::sendMedia(const std::string msg) {
+
+    //-- Same as sendMessage, plus what the player needs to report back.
+    yarp::os::Bottle bot;
+    bot.addString(msg);
+    bot.addInt32(++_media_seq);
+    bot.addFloat64(KeyInput::now());
+
+    _media_port.write(bot);
+
+    return _media_seq;
+}
+
+
+void EmbodiedSocialInterface::sendPrefetch(const std::vector<std::string>& clips) {
+
+    if (!_prefetch || _media_port.getOutputCount() == 0) {
+        return;
+    }
+
+    yarp::os::Bottle bot;
+    bot.addString("prefetch");
+    yarp::os::Bottle& list = bot.addList();
+    for (const auto& clip : clips) {
+        list.addString(clip);
+    }
+
+    _media_port.write(bot);
+
+    return;
+}
+
+
+std::vector<std::string> EmbodiedSocialInterface::outClips() {
+
+    //-- Do something slightly different for expressions.
+    if (_machine.getCurrentState() == "icub-expression") {
+        std::string prefix = _media_path + "/" + _machine.getCurrentState() + "_";
+        return { prefix + "correct_out.mp4", prefix + "wrong_out.mp4" };
+    }
+
+    return { _media_path + "/" + _machine.getStateHint("out") + ".mp4" };
+}
+
+
+void EmbodiedSocialInterface::readMediaStatus() {
+
+    yarp::os::Bottle* status;
+    while ((status = _media_status.read(false)) != nullptr) {
+
+        int    seq       = status->get(0).asInt32();
+        double sent      = status->get(1).asFloat64();
+        double loaded    = status->get(2).asFloat64();
+        double presented = status->get(3).asFloat64();
+
+        //-- Only the hints are timed; none, _out and celebrate clips aren't.
+        if (_hint_seqs.erase(seq) == 0) {
+            continue;
+        }
+
+        _load_latency.add(loaded - sent);
+        _present_latency.add(presented - sent);
+
+        if (seq == _hint_seq) {
+            _hint_latency = presented - sent;
+        }
+    }
+
+    return;
+}
+
+
+void EmbodiedSocialInterface::keyPressed(int key_num, double stamp) {
 
     //-- Deselect the from.
     if (selected_from == key_num) {
         selected_from = -1;
         selected_to   = -1;
+        _from_time    = -1.0;
+        _to_time      = -1.0;
         return;
     }
 
     //-- Deselect the to.
     if (selected_to == key_num) {
         selected_to = -1;
+        _to_time    = -1.0;
         return;
     }
 
@@ -436,22 +639,105 @@ void EmbodiedSocialInterface::keyPressed(int key_num) {
 
     if (selected_from == -1) {
         selected_from = key_num;
+        _from_time    = stamp;
     } else {
         selected_to = key_num; // overwrite.
+        _to_time    = stamp;
+    }
+
+    return;
+}
+
+
+void EmbodiedSocialInterface::disagree(const std::string& what) {
+    _disagreements.push_back(std::to_string(yarp::os::Time::now() - _start_time) + "s: " + what);
+
+    //-- Flushed per line, so a crash mid-game still leaves them behind.
+    if (!_disagree_log.is_open()) {
+        _disagree_log.open(_file_path + "/" + _user_name + "_disagreements.log");
     }
+    _disagree_log << _disagreements.back() << std::endl;
 
     return;
 }
 
 
-void EmbodiedSocialInterface::parseShowable(std::string str) {
+void EmbodiedSocialInterface::checkModel() {
+
+    if (!_expect_pending) {
+        return;
+    }
+
+    //-- The server has the final say; _model is already its board.
+    if (!_model.matches(_expected)) {
+        disagree("move #" + std::to_string(_move_count-1) + " drawn as " + _expected.toString() 
+               + ", server shows " + _model.toString());
+    }
+    _expect_pending = false;
 
-    std::stringstream ss(str);
-    showable_rows.clear();
+    return;
+}
 
-    std::string seg;
-    while (getline(ss, seg, '\n')) {
-        showable_rows.push_back(seg + "\n");
+
+void EmbodiedSocialInterface::queryBoard(yarp::os::Bottle& command, yarp::os::Bottle& response) {
+
+    if (_board_code && _model.valid()) {
+
+        communicate("code", command, response);
+        yarp::os::Value& reply = response.get(0);
+
+        //-- A server without ``code`` won't grow one; stop asking.
+        if (!reply.isInt32() && !reply.isInt64()) {
+            _board_code = false;
+        } else {
+
+            //-- Most ticks the board hasn't changed.
+            std::uint64_t code = static_cast<std::uint64_t>(reply.asInt64());
+            if (_has_code && code == _code) {
+                return;
+            }
+
+            _decoded = _model;
+            if (_decoded.decode(code)) {
+                _decoded.render(_coded);
+                parseShowable(_coded);
+                return;
+            }
+        }
+    }
+
+    //-- The full board, which also teaches _model what it looks like.
+    parseShowable(communicate("show", command, response));
+
+    return;
+}
+
+
+void EmbodiedSocialInterface::parseShowable(const std::string& str) {
+
+    //-- Most ticks the board hasn't changed.
+    if (str == _board && !_rows.empty()) {
+        return;
+    }
+
+    //-- Copy into the reused buffer, then index it in one pass.
+    _board.assign(str);
+    _board_changed = true;
+    _rows.clear();
+
+    std::string_view board(_board);
+    std::size_t start = 0;
+    while (start < board.size()) {
+        std::size_t end = board.find('\n', start);
+        if (end == std::string_view::npos) end = board.size();
+        _rows.push_back(board.substr(start, end - start));
+        start = end + 1;
+    }
+
+    //-- Keep the local copy of the game in step with what's shown.
+    if (_local_model) {
+        _model.parse(_rows, !board.empty() && board.back() == '\n');
+        _has_code = _model.encode(_code);
     }
     
     return;
@@ -460,8 +746,20 @@ void EmbodiedSocialInterface::parseShowable(std::string str) {
 
 void EmbodiedSocialInterface::drawInterface() {
 
-    //-- Reset and move the screen position.
-    clear(); move(0,0);
+    //-- Leave the screen alone unless something on it changed.
+    if (!_board_changed && selected_from == _drawn_from && selected_to == _drawn_to
+        && _move_count == _drawn_moves && _game_complete == _drawn_complete) {
+        return;
+    }
+    _board_changed  = false;
+    _drawn_from     = selected_from;
+    _drawn_to       = selected_to;
+    _drawn_moves    = _move_count;
+    _drawn_complete = _game_complete;
+
+    //-- Reset and move the screen position; erase() doesn't blank the
+    //-- terminal, so refresh() only sends the cells that differ.
+    erase(); move(0,0);
 
     //-- Right shift buffer.
     std::string shift(_right_shift, ' ');
@@ -487,93 +785,30 @@ void EmbodiedSocialInterface::drawInterface() {
     addstr((shift+line_buffer).c_str());
 
     //-- ROW SECTION 2: peg tops until disks.
-    for (int count = 0; count < _max_tower_height - (showable_rows.size()-2); ++count) {
-        addstr((shift+showable_rows[1]).c_str());
+    int num_rows = static_cast<int>(_rows.size());
+    for (int count = 0; num_rows > 2 && count < _max_tower_height - (num_rows-2); ++count) {
+        drawRow(shift, _rows[1]);
     }
 
     //-- ROW SECTION 3: disks until base.
-    for (int idx = 2; idx < showable_rows.size()-1; ++idx) {
-        addstr((shift+showable_rows[idx]).c_str());
+    for (int idx = 2; idx < num_rows-1; ++idx) {
+        drawRow(shift, _rows[idx]);
     }
 
-    //-- ROW SECTION 4: disk selections.
-    line_buffer = std::string(6, ' ') 
-        + "[1]" + std::string(8, ' ') 
-        + "[2]" + std::string(8, ' ') 
-        + "[3]" + "\n";
-    addstr((shift+line_buffer).c_str());
-
-    // This is embarrassing and sucks but formatting...
-    std::vector<int> MAGIC_FORMAT {0, 5, 16, 27}; 
-
-    //-- Clear the buffer.
-    line_buffer = shift+std::string(MAGIC_FORMAT[0], ' ');
-    if (selected_from != -1 && selected_to == -1) {
-        line_buffer += std::string(MAGIC_FORMAT[selected_from], ' ') + "^^^^^" + "\n" + shift
-                     + std::string(MAGIC_FORMAT[selected_from], ' ') + "FROM " + "\n\n";
-    } else if (selected_from != -1 && selected_to != -1) {
-
-        // Do the selected row first.
-        if (selected_from == 1 || selected_to == 1) {
-            line_buffer += std::string(5, ' ') + "^^^^^";
-        } else {
-            line_buffer += std::string(10, ' ');
-        }
-
-        if (selected_from == 2 || selected_to == 2) {
-            line_buffer += std::string(6, ' ') + "^^^^^";
-        } else {
-            line_buffer += std::string(11, ' ');
-        }
-
-        if (selected_from == 3 || selected_to == 3) {
-            line_buffer += std::string(6, ' ') + "^^^^^";
-        } else {
-            line_buffer += std::string(11, ' ');
-        }
-        line_buffer += "\n" + shift;
-
-        //-- Fill peg 1 if selected as FROM or TO
-        if (selected_from == 1) {
-            line_buffer += std::string(5, ' ') + "FROM ";
-        } else if (selected_to == 1) {
-            line_buffer += std::string(5, ' ') + " TO  ";
-        } else {
-            line_buffer += std::string(10, ' ');
-        }
-
-        //-- Fill peg 2 if selected as FROM or TO
-        if (selected_from == 2) {
-            line_buffer += std::string(6, ' ') + "FROM ";
-        } else if (selected_to == 2) {
-            line_buffer += std::string(6, ' ') + " TO  ";
-        } else {
-            line_buffer += std::string(11, ' ');
-        }
-
-        //-- Fill peg 3 if selected as FROM or TO
-        if (selected_from == 3) {
-            line_buffer += std::string(6, ' ') + "FROM ";
-        } else if (selected_to == 3) {
-            line_buffer += std::string(6, ' ') + " TO  ";
-        } else {
-            line_buffer += std::string(11, ' ');
-        }
-        line_buffer += "\n" + shift;
-
-        std::string enter_buffer = "[ENTER]";
-        line_buffer += std::string( (_window_width - enter_buffer.length() + 1)/2, ' ')  + enter_buffer + "\n";
-
-    } else {
-        // Nothing selected...
-        line_buffer = "\n\n\n"; 
-    }
+    //-- ROW SECTION 4: disk selections, from the precomputed layout.
+    addstr(_layout.labels().c_str());
+    addstr(_layout.selector(selected_from, selected_to).c_str());
 
+    refresh();
 
-    addstr(line_buffer.c_str());
+    return;
+}
 
-    refresh();
 
+void EmbodiedSocialInterface::drawRow(const std::string& shift, std::string_view row) {
+    addnstr(shift.data(), shift.size());
+    addnstr(row.data(), row.size());
+    addch('\n');
     return;
 }
 
@@ -581,7 +816,10 @@ void EmbodiedSocialInterface::drawInterface() {
 void EmbodiedSocialInterface::drawWaiting() {
 
     //-- Reset and move the screen position.
-    clear(); move(0,0);
+    erase(); move(0,0);
+
+    //-- The board goes back up once the server is.
+    _board_changed = true;
 
     //-- Little waiting animation.
     std::vector<std::string> waiting = { " \\", " ─ ", " / ", " | " }; 
@@ -0,0 +1,292 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <hanoiModel.hpp>
+
+#include <algorithm>
+
+
+HanoiModel::HanoiModel() :
+    _valid(false),
+    _levels(0),
+    _newline(false) {
+}
+
+
+bool HanoiModel::parse(const std::vector<std::string_view>& rows, bool newline) {
+
+    _valid = false;
+    _pegs.clear();
+    _centers.clear();
+    _glyphs.clear();
+    _offsets.clear();
+
+    //-- At least a header, the peg tops and the base.
+    int num_rows = static_cast<int>(rows.size());
+    if (num_rows < 3) {
+        return false;
+    }
+
+    _header.assign(rows[0]);
+    _top.assign(rows[1]);
+    _base.assign(rows[num_rows-1]);
+    _levels  = num_rows - 3;
+    _newline = newline;
+
+    //-- The pegs are wherever the tops are.
+    for (std::size_t col = 0; col < _top.size(); ++col) {
+        if (_top[col] == '|') _centers.push_back(static_cast<int>(col));
+    }
+    if (_centers.size() < 2) {
+        return false;
+    }
+
+    int num_pegs = static_cast<int>(_centers.size());
+
+    //-- Read each peg from the base up, by disk width for now.
+    struct Disk { int width; std::string glyph; int offset; };
+    std::vector<Disk> disks;
+    std::vector<std::vector<int>> widths(num_pegs);
+    std::vector<bool> bare(num_pegs, false);
+
+    std::string glyph;
+    int offset;
+    for (int row = num_rows-2; row >= 2; --row) {
+        for (int peg = 0; peg < num_pegs; ++peg) {
+
+            if (!readDisk(rows[row], peg, glyph, offset)) {
+                bare[peg] = true;
+                continue;
+            }
+
+            //-- A floating disk, or a bigger one on a smaller.
+            int width = static_cast<int>(glyph.size());
+            if (bare[peg] || (!widths[peg].empty() && widths[peg].back() <= width)) {
+                return false;
+            }
+
+            widths[peg].push_back(width);
+            disks.push_back({ width, glyph, offset });
+        }
+    }
+
+    //-- Number the disks by size, which has to tell them apart.
+    std::sort(disks.begin(), disks.end(), [](const Disk& a, const Disk& b) { return a.width < b.width; });
+    for (std::size_t idx = 1; idx < disks.size(); ++idx) {
+        if (disks[idx].width == disks[idx-1].width) return false;
+    }
+
+    for (const auto& disk : disks) {
+        _glyphs.push_back(disk.glyph);
+        _offsets.push_back(disk.offset);
+    }
+
+    _pegs.assign(num_pegs, {});
+    for (int peg = 0; peg < num_pegs; ++peg) {
+        for (int width : widths[peg]) {
+            auto found = std::lower_bound(disks.begin(), disks.end(), width,
+                [](const Disk& disk, int w) { return disk.width < w; });
+            _pegs[peg].push_back(static_cast<int>(found - disks.begin()));
+        }
+    }
+
+    _valid = true;
+    return true;
+}
+
+
+bool HanoiModel::valid() const {
+    return _valid;
+}
+
+
+int HanoiModel::numPegs() const {
+    return static_cast<int>(_pegs.size());
+}
+
+
+int HanoiModel::numDisks() const {
+    return static_cast<int>(_glyphs.size());
+}
+
+
+bool HanoiModel::legal(int from, int to) const {
+
+    if (!_valid || from == to || from < 0 || to < 0 || from >= numPegs() || to >= numPegs()) {
+        return false;
+    }
+
+    //-- Something to move, onto nothing or a bigger disk.
+    if (_pegs[from].empty()) {
+        return false;
+    }
+
+    return _pegs[to].empty() || _pegs[to].back() > _pegs[from].back();
+}
+
+
+bool HanoiModel::apply(int from, int to) {
+
+    if (!legal(from, to)) {
+        return false;
+    }
+
+    _pegs[to].push_back(_pegs[from].back());
+    _pegs[from].pop_back();
+
+    return true;
+}
+
+
+bool HanoiModel::matches(const HanoiModel& other) const {
+    return _valid && other._valid && _pegs == other._pegs;
+}
+
+
+int HanoiModel::maxDisks(int num_pegs) {
+
+    if (num_pegs < 2) {
+        return 0;
+    }
+
+    //-- Digits until num_pegs^n would no longer fit.
+    int disks = 0;
+    for (std::uint64_t span = 1; span <= UINT64_MAX / num_pegs; span *= num_pegs) {
+        disks++;
+    }
+
+    return disks;
+}
+
+
+bool HanoiModel::encode(std::uint64_t& code) const {
+
+    if (!_valid || numDisks() > maxDisks(numPegs())) {
+        return false;
+    }
+
+    std::vector<int> peg_of(numDisks());
+    for (int peg = 0; peg < numPegs(); ++peg) {
+        for (int disk : _pegs[peg]) peg_of[disk] = peg;
+    }
+
+    //-- Biggest disk first, so it ends up the highest digit.
+    code = 0;
+    for (int disk = numDisks()-1; disk >= 0; --disk) {
+        code = code * numPegs() + peg_of[disk];
+    }
+
+    return true;
+}
+
+
+bool HanoiModel::decode(std::uint64_t code) {
+
+    if (!_valid || numDisks() > maxDisks(numPegs())) {
+        return false;
+    }
+
+    std::vector<int> peg_of(numDisks());
+    for (int disk = 0; disk < numDisks(); ++disk) {
+        peg_of[disk] = static_cast<int>(code % numPegs());
+        code /= numPegs();
+    }
+
+    //-- Digits left over are disks this board doesn't have.
+    if (code != 0) {
+        return false;
+    }
+
+    //-- Restack, biggest disks at the bottom.
+    for (auto& peg : _pegs) peg.clear();
+    for (int disk = numDisks()-1; disk >= 0; --disk) {
+        _pegs[peg_of[disk]].push_back(disk);
+    }
+
+    return true;
+}
+
+
+std::string HanoiModel::toString() const {
+
+    std::string str;
+    for (const auto& peg : _pegs) {
+        if (!str.empty()) str += " ";
+        str += "(";
+        for (std::size_t idx = 0; idx < peg.size(); ++idx) {
+            if (idx != 0) str += " ";
+            str += std::to_string(peg[idx]);
+        }
+        str += ")";
+    }
+
+    return str;
+}
+
+
+void HanoiModel::render(std::string& board) const {
+
+    board.clear();
+    board.append(_header).append(1, '\n');
+    board.append(_top).append(1, '\n');
+
+    //-- Every disk row starts as bare pegs, disks are laid over it.
+    for (int row = 0; row < _levels; ++row) {
+
+        std::size_t level = _levels - 1 - row; // 0 at the base.
+        std::string line(_top);
+
+        for (int peg = 0; peg < numPegs(); ++peg) {
+
+            if (level >= _pegs[peg].size()) continue;
+
+            int disk = _pegs[peg][level];
+            std::size_t start = _centers[peg] - _offsets[disk];
+            if (start + _glyphs[disk].size() > line.size()) {
+                line.resize(start + _glyphs[disk].size(), ' ');
+            }
+            line.replace(start, _glyphs[disk].size(), _glyphs[disk]);
+        }
+
+        board.append(line).append(1, '\n');
+    }
+
+    board.append(_base);
+    if (_newline) board.append(1, '\n');
+
+    return;
+}
+
+
+bool HanoiModel::readDisk(std::string_view row, int peg, std::string& glyph, int& offset) const {
+
+    int center = _centers[peg];
+    int size   = static_cast<int>(row.size());
+    if (center >= size || row[center] == ' ' || row[center] == '|') {
+        return false;
+    }
+
+    //-- Don't run into the neighbouring pegs' disks.
+    int lo = (peg == 0 ? 0 : (_centers[peg-1] + center) / 2 + 1);
+    int last = static_cast<int>(_centers.size()) - 1;
+    int hi = (peg == last ? size : std::min(size, (center + _centers[peg+1]) / 2 + 1));
+
+    int left = center;
+    while (left > lo && row[left-1] != ' ') --left;
+    int right = center + 1;
+    while (right < hi && row[right] != ' ') ++right;
+
+    glyph.assign(row.substr(left, right - left));
+    offset = center - left;
+
+    return true;
+}
@@ -0,0 +1,132 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <keyInput.hpp>
+
+
+KeyInput::KeyInput() : _head(0), _tail(0), _dropped(0), _fd(-1), _running(false) {
+}
+
+
+KeyInput::~KeyInput() {
+    stop();
+}
+
+
+bool KeyInput::start(int fd/*=STDIN_FILENO*/) {
+
+    if (_running) {
+        return false;
+    }
+
+    _fd = fd;
+    _running = true;
+    _reader = std::thread(&KeyInput::readLoop, this);
+
+    return true;
+}
+
+
+void KeyInput::stop() {
+
+    _running = false;
+    if (_reader.joinable()) {
+        _reader.join();
+    }
+
+    return;
+}
+
+
+bool KeyInput::pop(KeyPress& key) {
+
+    std::size_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    key = _ring[head % CAPACITY];
+    _head.store(head + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+void KeyInput::clear() {
+    KeyPress key;
+    while (pop(key)) {}
+    return;
+}
+
+
+std::size_t KeyInput::dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+
+double KeyInput::now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+void KeyInput::readLoop() {
+
+    struct pollfd pfd;
+    pfd.fd     = _fd;
+    pfd.events = POLLIN;
+
+    unsigned char buffer[32];
+    while (_running) {
+
+        //-- Wake up now and then to see if we've been stopped.
+        if (poll(&pfd, 1, 50) <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+
+        //-- Everything in one read arrived together, so it shares a stamp.
+        double stamp = KeyInput::now();
+        ssize_t len = read(_fd, buffer, sizeof(buffer));
+        if (len <= 0) {
+            continue;
+        }
+
+        for (ssize_t idx = 0; idx < len; ++idx) {
+
+            //-- Escape sequences (arrows, function keys) are not ours; 
+            //-- skip the rest of the read so their digits don't leak in.
+            if (buffer[idx] == 27) {
+                break;
+            }
+
+            push({ buffer[idx], stamp });
+        }
+    }
+
+    return;
+}
+
+
+void KeyInput::push(const KeyPress& key) {
+
+    std::size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) >= CAPACITY) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    _ring[tail % CAPACITY] = key;
+    _tail.store(tail + 1, std::memory_order_release);
+
+    return;
+}
@@ -0,0 +1,71 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <latencyStats.hpp>
+
+
+LatencyStats::LatencyStats() {
+    clear();
+}
+
+
+void LatencyStats::clear() {
+    _samples.clear();
+    _max = 0.0;
+    return;
+}
+
+
+void LatencyStats::add(double latency) {
+    _max = (_samples.empty() ? latency : std::max(_max, latency));
+    _samples.push_back(latency);
+    return;
+}
+
+
+std::size_t LatencyStats::count() const {
+    return _samples.size();
+}
+
+
+double LatencyStats::max() const {
+    return _max;
+}
+
+
+double LatencyStats::percentile(double q) const {
+
+    if (_samples.empty()) {
+        return 0.0;
+    }
+
+    //-- Nearest rank, on a copy so samples can keep coming in order.
+    std::vector<double> sorted(_samples);
+    std::size_t rank = static_cast<std::size_t>(q * (sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+
+    return sorted[rank];
+}
+
+
+void LatencyStats::addTo(yarp::os::Bottle& reply, const std::string name) const {
+
+    yarp::os::Bottle& stats = reply.addList();
+    stats.addString(name);
+    stats.addString("n");   stats.addInt32(static_cast<int>(count()));
+    stats.addString("p50"); stats.addFloat64(percentile(0.50));
+    stats.addString("p90"); stats.addFloat64(percentile(0.90));
+    stats.addString("p99"); stats.addFloat64(percentile(0.99));
+    stats.addString("max"); stats.addFloat64(max());
+
+    return;
+}
@@ -0,0 +1,125 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef RPC_LOAD_TEST_HPP
+#define RPC_LOAD_TEST_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/RpcClient.h>
+
+
+/* ================================================================================
+**  Drives an RPC port (e.g. /clipMaker/rpc) from several clients at once with
+**  a weighted mix of commands, and reports throughput, latency and errors.
+** ================================================================================ */
+class RpcLoadTest {
+
+    private:
+    /* ============================================================================
+    **  A command of the mix and how often to pick it, relative to the others.
+    ** ============================================================================ */
+    struct Command {
+        std::string      text;
+        yarp::os::Bottle bottle;
+        double           weight;
+    };
+
+
+    /* ============================================================================
+    **  One request as seen by a client.
+    ** ============================================================================ */
+    struct Sample {
+        std::size_t command;  // index into the mix.
+        double      latency;  // seconds.
+        bool        error;
+    };
+
+
+    /* ============================================================================
+    **  Settings for the test.
+    ** ============================================================================ */
+    std::string _module_name;
+    std::string _remote;
+    int         _num_clients;
+    double      _duration;
+    double      _rate;      // requests/s per client, 0 for back to back.
+    double      _timeout;
+    std::vector<Command> _mix;
+
+    std::vector<yarp::os::RpcClient*> _clients;
+    std::vector<std::vector<Sample>>  _samples;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    RpcLoadTest();
+
+
+    /* ============================================================================
+    **  Destructor. Closes any open clients.
+    ** ============================================================================ */
+    ~RpcLoadTest();
+
+
+    /* ============================================================================
+    **  Read the settings and connect the clients to the remote port.
+    **
+    ** @param rf
+    **
+    ** @return success of opening and connecting every client.
+    ** ============================================================================ */
+    bool configure(yarp::os::ResourceFinder &rf);
+
+
+    /* ============================================================================
+    **  Run all clients for the duration, then print the report.
+    **
+    ** @return false if any request failed.
+    ** ============================================================================ */
+    bool run();
+
+
+    private:
+    /* ============================================================================
+    **  Request loop of a single client.
+    ** ============================================================================ */
+    void client(std::size_t idx, double until);
+
+
+    /* ============================================================================
+    **  Print count, errors and latency percentiles for a set of samples.
+    ** ============================================================================ */
+    void report(const std::string name, std::vector<double>& latencies, std::size_t errors, double elapsed);
+
+
+    /* ============================================================================
+    **  Get the value at fraction q of sorted latencies.
+    ** ============================================================================ */
+    static double percentile(const std::vector<double>& sorted, double q);
+
+};
+
+#endif /* RPC_LOAD_TEST_HPP */
@@ -0,0 +1,201 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <rpcLoadTest.hpp>
+
+
+RpcLoadTest::RpcLoadTest() :
+    _num_clients(0), _duration(0.0), _rate(0.0), _timeout(0.0) {
+}
+
+
+RpcLoadTest::~RpcLoadTest() {
+    for (yarp::os::RpcClient* client : _clients) {
+        client->close();
+        delete client;
+    }
+    _clients.clear();
+}
+
+
+bool RpcLoadTest::configure(yarp::os::ResourceFinder &rf) {
+
+    //-- Get some variables from the configuration file that the resource finder loaded.
+    _module_name = rf.check("name",     yarp::os::Value("/rpcLoadTest"),   "module name (string)").asString();
+    _remote      = rf.check("remote",   yarp::os::Value("/clipMaker/rpc"), "port under test (string)").asString();
+    _num_clients = rf.check("clients",  yarp::os::Value(4),    "number of clients (int)").asInt32();
+    _duration    = rf.check("duration", yarp::os::Value(10.0), "test length in seconds (double)").asFloat64();
+    _rate        = rf.check("rate",     yarp::os::Value(0.0),  "requests/s per client, 0 for max (double)").asFloat64();
+    _timeout     = rf.check("timeout",  yarp::os::Value(5.0),  "reply timeout in seconds (double)").asFloat64();
+
+    if (_num_clients <= 0 || _duration <= 0.0) {
+        yError("%s: clients and duration must be positive!!", _module_name.c_str());
+        return false;
+    }
+
+    //-- The mix is given as ``((<command> <weight>) ...)``, defaulting to help.
+    yarp::os::Bottle* mix = rf.find("mix").asList();
+    for (int idx = 0; mix && idx < mix->size(); ++idx) {
+
+        yarp::os::Bottle* entry = mix->get(idx).asList();
+        if (entry == NULL || entry->size() != 2 || entry->get(1).asFloat64() <= 0.0) {
+            yError("%s: Mix entries must be given as (\"<command>\" <weight>)!!", _module_name.c_str());
+            return false;
+        }
+
+        Command command;
+        command.text   = entry->get(0).asString();
+        command.weight = entry->get(1).asFloat64();
+        command.bottle.fromString(command.text);
+        _mix.push_back(command);
+    }
+
+    if (_mix.empty()) {
+        Command command;
+        command.text   = "help";
+        command.weight = 1.0;
+        command.bottle.fromString(command.text);
+        _mix.push_back(command);
+    }
+
+    //-- Open and connect every client.
+    for (int idx = 0; idx < _num_clients; ++idx) {
+
+        yarp::os::RpcClient* client = new yarp::os::RpcClient();
+        _clients.push_back(client);
+
+        std::string port_name = _module_name + "/client" + std::to_string(idx);
+        if (!client->open(port_name)) {
+            yError("%s: Unable to open port %s!!", _module_name.c_str(), port_name.c_str());
+            return false;
+        }
+        client->setTimeout(static_cast<float>(_timeout));
+
+        if (!yarp::os::Network::connect(port_name, _remote)) {
+            yError("%s: Unable to connect %s to %s!!", _module_name.c_str(), port_name.c_str(), _remote.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool RpcLoadTest::run() {
+
+    _samples.assign(_clients.size(), std::vector<Sample>());
+
+    yInfo("%s: %zu clients on %s for %.1f s", _module_name.c_str(), _clients.size(), _remote.c_str(), _duration);
+
+    //-- All clients share one start and end time.
+    auto   start  = std::chrono::steady_clock::now();
+    double until  = _duration;
+    std::vector<std::thread> threads;
+    for (std::size_t idx = 0; idx < _clients.size(); ++idx) {
+        threads.emplace_back(&RpcLoadTest::client, this, idx, until);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //-- Overall, then per command.
+    std::vector<double> all;
+    std::vector<std::vector<double>> per_command(_mix.size());
+    std::vector<std::size_t> errors(_mix.size(), 0);
+    std::size_t total_errors = 0;
+
+    for (const std::vector<Sample>& samples : _samples) {
+        for (const Sample& sample : samples) {
+            all.push_back(sample.latency);
+            per_command[sample.command].push_back(sample.latency);
+            if (sample.error) {
+                errors[sample.command]++;
+                total_errors++;
+            }
+        }
+    }
+
+    std::printf("%-24s %8s %8s %10s %9s %9s %9s %9s\n", "command", "count", "errors", "req/s", "p50 ms", "p90 ms", "p99 ms", "max ms");
+    report("all", all, total_errors, elapsed);
+    for (std::size_t idx = 0; idx < _mix.size(); ++idx) {
+        report(_mix[idx].text, per_command[idx], errors[idx], elapsed);
+    }
+
+    return (total_errors == 0);
+}
+
+
+void RpcLoadTest::client(std::size_t idx, double until) {
+
+    yarp::os::RpcClient& port = *_clients[idx];
+    std::vector<Sample>& samples = _samples[idx];
+
+    //-- Each client draws its own sequence from the weighted mix.
+    std::vector<double> weights;
+    for (const Command& command : _mix) weights.push_back(command.weight);
+    std::mt19937 gen(static_cast<unsigned int>(idx + 1));
+    std::discrete_distribution<std::size_t> pick(weights.begin(), weights.end());
+
+    auto start = std::chrono::steady_clock::now();
+    auto seconds = [&start] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    for (std::size_t count = 0; seconds() < until; ++count) {
+
+        //-- At a fixed rate, latency counts from when the request was due
+        //-- so that a slow server can't hide its queueing delay.
+        double due = seconds();
+        if (_rate > 0.0) {
+            due = count / _rate;
+            if (due >= until) break;
+            std::this_thread::sleep_until(start + std::chrono::duration<double>(due));
+        }
+
+        Sample sample;
+        sample.command = pick(gen);
+
+        yarp::os::Bottle rsp;
+        bool ok = port.write(_mix[sample.command].bottle, rsp);
+
+        sample.latency = seconds() - due;
+
+        //-- Anything but a reply that isn't flagged as an error counts as one.
+        std::string head = (rsp.size() > 0 ? rsp.get(0).asString() : "");
+        sample.error = !ok || rsp.size() == 0 || head == "err" || head == "nack" || head.rfind("[error]", 0) == 0;
+
+        samples.push_back(sample);
+    }
+
+    return;
+}
+
+
+void RpcLoadTest::report(const std::string name, std::vector<double>& latencies, std::size_t errors, double elapsed) {
+
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("%-24s %8zu %8zu %10.1f %9.3f %9.3f %9.3f %9.3f\n",
+        name.c_str(), latencies.size(), errors, latencies.size() / elapsed,
+        percentile(latencies, 0.50) * 1e3, percentile(latencies, 0.90) * 1e3,
+        percentile(latencies, 0.99) * 1e3, (latencies.empty() ? 0.0 : latencies.back() * 1e3));
+
+    return;
+}
+
+
+double RpcLoadTest::percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    std::size_t idx = static_cast<std::size_t>(q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
@@ -0,0 +1,62 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef CSV_TOKENIZER_HPP
+#define CSV_TOKENIZER_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+
+/* ================================================================================
+**  Splits CsvLogger output into rows of fields without copying. The logger
+**  never quotes, so a field is anything between commas; '\r' is dropped.
+** ================================================================================ */
+class CsvTokenizer {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the tokenizer.
+    ** ============================================================================ */
+    std::string_view _text;
+    std::size_t _pos;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    **
+    ** @param text : whole file contents; must outlive the fields.
+    ** ============================================================================ */
+    CsvTokenizer(std::string_view text);
+
+
+    /* ============================================================================
+    **  Split the next non-empty row into fields.
+    **
+    ** @return false once the text is used up.
+    ** ============================================================================ */
+    bool next(std::vector<std::string_view>& fields);
+
+
+    /* ============================================================================
+    **  Parse a field as a number, returning the fallback if it isn't one.
+    ** ============================================================================ */
+    static int    toInt(std::string_view field, int fallback);
+    static double toDouble(std::string_view field, double fallback);
+
+};
+
+#endif /* CSV_TOKENIZER_HPP */
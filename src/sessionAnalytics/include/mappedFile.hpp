@@ -0,0 +1,78 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/* ================================================================================
+**  A whole file mapped read-only for a single sequential pass.
+** ================================================================================ */
+class MappedFile {
+
+    private:
+    /* ============================================================================
+    **  Internal members for the mapping.
+    ** ============================================================================ */
+    const char* _data;
+    std::size_t _size;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    MappedFile();
+
+
+    /* ============================================================================
+    **  Destructor. Unmaps the file.
+    ** ============================================================================ */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+
+    /* ============================================================================
+    **  Map a file, unmapping any previous one.
+    **
+    ** @param fname  file to map.
+    **
+    ** @return success of opening and mapping the file (empty files included).
+    ** ============================================================================ */
+    bool open(const std::string& fname);
+
+
+    /* ============================================================================
+    **  Unmap the file.
+    ** ============================================================================ */
+    void close();
+
+
+    /* ============================================================================
+    **  Contents of the file.
+    ** ============================================================================ */
+    std::string_view view() const;
+
+};
+
+#endif /* MAPPED_FILE_HPP */
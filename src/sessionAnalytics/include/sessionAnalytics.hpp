@@ -0,0 +1,122 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef SESSION_ANALYTICS_HPP
+#define SESSION_ANALYTICS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/ResourceFinder.h>
+
+#include <csvTokenizer.hpp>
+#include <mappedFile.hpp>
+
+
+/* ================================================================================
+**  Reads every CsvLogger file under a directory, spread over a pool of
+**  threads, and writes per user and per channel move statistics as a CSV.
+** ================================================================================ */
+class SessionAnalytics {
+
+    private:
+    /* ============================================================================
+    **  Running totals for one table row; merged across files and threads.
+    ** ============================================================================ */
+    struct Stats {
+        std::size_t sessions = 0;   // files with moves in this row.
+        std::size_t moves    = 0;
+        std::size_t followed = 0;   // moves that matched the hint.
+        double      progress = 0.0; // total reduction of ``dist`` over the moves.
+        std::size_t gaps     = 0;   // inter-move times, in seconds.
+        double      gap_sum  = 0.0;
+        double      gap_sq   = 0.0;
+        double      gap_max  = 0.0;
+
+        void merge(const Stats& other, bool with_sessions);
+    };
+
+    //-- Rows keyed by (user, channel). ``*`` stands for all of either.
+    typedef std::map<std::pair<std::string, std::string>, Stats> Table;
+
+
+    /* ============================================================================
+    **  Settings for the analysis.
+    ** ============================================================================ */
+    std::string _module_name;
+    std::string _fpath;
+    std::string _output;
+    int         _num_threads;
+
+    std::vector<std::string> _files;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    SessionAnalytics();
+
+
+    /* ============================================================================
+    **  Read the settings and find the session logs.
+    **
+    ** @param rf
+    **
+    ** @return success of finding the log directory.
+    ** ============================================================================ */
+    bool configure(yarp::os::ResourceFinder &rf);
+
+
+    /* ============================================================================
+    **  Parse every log and write the summary.
+    **
+    ** @return false if the summary could not be written.
+    ** ============================================================================ */
+    bool run();
+
+
+    private:
+    /* ============================================================================
+    **  Parse files off the shared counter until there are none left.
+    ** ============================================================================ */
+    void worker(std::atomic<std::size_t>& next, Table& table, std::size_t& rows, std::size_t& skipped);
+
+
+    /* ============================================================================
+    **  Add the moves of one session log to a table.
+    **
+    ** @return false if the file could not be read or lacks needed columns.
+    ** ============================================================================ */
+    bool parseFile(const std::string& fname, Table& table, std::size_t& rows);
+
+
+    /* ============================================================================
+    **  Roll the per (user, channel) rows up into the ``*`` rows and write
+    **  them all out.
+    ** ============================================================================ */
+    bool writeSummary(const Table& table);
+
+};
+
+#endif /* SESSION_ANALYTICS_HPP */
@@ -0,0 +1,66 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <csvTokenizer.hpp>
+
+
+CsvTokenizer::CsvTokenizer(std::string_view text) : _text(text), _pos(0) {
+}
+
+
+bool CsvTokenizer::next(std::vector<std::string_view>& fields) {
+
+    fields.clear();
+
+    while (_pos < _text.size()) {
+
+        //-- Find the end of the row.
+        const char* begin = _text.data() + _pos;
+        const char* found = static_cast<const char*>(std::memchr(begin, '\n', _text.size() - _pos));
+        std::size_t len   = (found ? found - begin : _text.size() - _pos);
+        _pos += len + 1;
+
+        std::string_view row(begin, len);
+        if (!row.empty() && row.back() == '\r') row.remove_suffix(1);
+        if (row.empty()) continue;
+
+        //-- Split on every comma.
+        std::size_t start = 0;
+        while (true) {
+            std::size_t comma = row.find(',', start);
+            if (comma == std::string_view::npos) {
+                fields.push_back(row.substr(start));
+                break;
+            }
+            fields.push_back(row.substr(start, comma - start));
+            start = comma + 1;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+
+int CsvTokenizer::toInt(std::string_view field, int fallback) {
+    int value;
+    auto res = std::from_chars(field.data(), field.data() + field.size(), value);
+    return (res.ec == std::errc() ? value : fallback);
+}
+
+
+double CsvTokenizer::toDouble(std::string_view field, double fallback) {
+    double value;
+    auto res = std::from_chars(field.data(), field.data() + field.size(), value);
+    return (res.ec == std::errc() ? value : fallback);
+}
@@ -0,0 +1,38 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <iostream>
+#include <string>
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/ResourceFinder.h>
+
+#include <sessionAnalytics.hpp>
+
+
+int main (int argc, char **argv) {
+
+    //-- Config the resource finder. No yarp server is needed for this one.
+    yarp::os::ResourceFinder rf;
+    rf.setVerbose(false);
+    rf.setDefaultConfigFile("config.ini");      // overridden by --from parameter
+    rf.setDefaultContext("session_analytics");  // overridden by --context parameter
+    rf.configure(argc,argv);
+
+    //-- Run the analysis and return its status.
+    SessionAnalytics session_analytics;
+    if (!session_analytics.configure(rf)) {
+        return EXIT_FAILURE;
+    }
+
+    return (session_analytics.run() ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,77 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <mappedFile.hpp>
+
+
+MappedFile::MappedFile() : _data(nullptr), _size(0) {
+}
+
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+
+bool MappedFile::open(const std::string& fname) {
+
+    close();
+
+    int fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    //-- Nothing to map, but nothing wrong either.
+    if (st.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file.
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    //-- Read front to back once.
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    _data = static_cast<const char*>(data);
+    _size = st.st_size;
+
+    return true;
+}
+
+
+void MappedFile::close() {
+
+    if (_data != nullptr) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+
+    _data = nullptr;
+    _size = 0;
+
+    return;
+}
+
+
+std::string_view MappedFile::view() const {
+    return std::string_view(_data, _size);
+}
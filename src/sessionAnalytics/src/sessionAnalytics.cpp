@@ -0,0 +1,269 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <sessionAnalytics.hpp>
+
+
+void SessionAnalytics::Stats::merge(const Stats& other, bool with_sessions) {
+
+    if (with_sessions) sessions += other.sessions;
+    moves    += other.moves;
+    followed += other.followed;
+    progress += other.progress;
+    gaps     += other.gaps;
+    gap_sum  += other.gap_sum;
+    gap_sq   += other.gap_sq;
+    gap_max   = std::max(gap_max, other.gap_max);
+
+    return;
+}
+
+
+SessionAnalytics::SessionAnalytics() : _num_threads(0) {
+}
+
+
+bool SessionAnalytics::configure(yarp::os::ResourceFinder &rf) {
+
+    //-- Get some variables from the configuration file that the resource finder loaded.
+    _module_name = rf.check("name",    yarp::os::Value("/sessionAnalytics"),     "module name (string)").asString();
+    _fpath       = rf.check("fpath",   yarp::os::Value("./"),                    "session log path (string)").asString();
+    _output      = rf.check("output",  yarp::os::Value("session_summary.csv"),   "summary file (string)").asString();
+    _num_threads = rf.check("threads", yarp::os::Value(0), "parser threads, 0 for one per core (int)").asInt32();
+
+    if (_num_threads <= 0) {
+        _num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    //-- Every csv under the path is taken to be a session log.
+    std::error_code err;
+    if (!std::filesystem::is_directory(_fpath, err)) {
+        yError("%s: %s is not a directory!!", _module_name.c_str(), _fpath.c_str());
+        return false;
+    }
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(_fpath, err)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+            _files.push_back(entry.path().string());
+        }
+    }
+
+    return true;
+}
+
+
+bool SessionAnalytics::run() {
+
+    yInfo("%s: %zu session logs under %s on %d threads", _module_name.c_str(), _files.size(), _fpath.c_str(), _num_threads);
+
+    //-- Each thread keeps a table of its own; they're merged at the end.
+    auto start = std::chrono::steady_clock::now();
+
+    std::atomic<std::size_t> next(0);
+    std::vector<Table> tables(_num_threads);
+    std::vector<std::size_t> rows(_num_threads, 0), skipped(_num_threads, 0);
+
+    std::vector<std::thread> threads;
+    for (int idx = 0; idx < _num_threads; ++idx) {
+        threads.emplace_back(&SessionAnalytics::worker, this, std::ref(next), 
+            std::ref(tables[idx]), std::ref(rows[idx]), std::ref(skipped[idx]));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    Table table;
+    std::size_t total_rows = 0, total_skipped = 0;
+    for (int idx = 0; idx < _num_threads; ++idx) {
+        for (const auto& row : tables[idx]) {
+            table[row.first].merge(row.second, true);
+        }
+        total_rows    += rows[idx];
+        total_skipped += skipped[idx];
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    yInfo("%s: %zu rows from %zu logs in %.3f s (%.0f rows/s), %zu skipped", _module_name.c_str(), 
+        total_rows, _files.size() - total_skipped, elapsed, (elapsed > 0.0 ? total_rows / elapsed : 0.0), total_skipped);
+
+    return writeSummary(table);
+}
+
+
+void SessionAnalytics::worker(std::atomic<std::size_t>& next, Table& table, std::size_t& rows, std::size_t& skipped) {
+
+    for (std::size_t idx = next++; idx < _files.size(); idx = next++) {
+        if (!parseFile(_files[idx], table, rows)) {
+            yWarning("%s: Skipping %s", _module_name.c_str(), _files[idx].c_str());
+            skipped++;
+        }
+    }
+
+    return;
+}
+
+
+bool SessionAnalytics::parseFile(const std::string& fname, Table& table, std::size_t& rows) {
+
+    MappedFile file;
+    if (!file.open(fname)) {
+        return false;
+    }
+
+    CsvTokenizer csv(file.view());
+    std::vector<std::string_view> fields;
+    fields.reserve(16);
+
+    //-- Find the columns by name, so logs from before any were added still work.
+    if (!csv.next(fields)) {
+        return false;
+    }
+
+    int col_time = -1, col_user = -1, col_channel = -1, col_hint = -1, col_dist = -1, col_from = -1, col_to = -1;
+    for (int idx = 0; idx < static_cast<int>(fields.size()); ++idx) {
+        if      (fields[idx] == "int_time") col_time    = idx;
+        else if (fields[idx] == "user_id")  col_user    = idx;
+        else if (fields[idx] == "channel")  col_channel = idx;
+        else if (fields[idx] == "hint_id")  col_hint    = idx;
+        else if (fields[idx] == "dist")     col_dist    = idx;
+        else if (fields[idx] == "from")     col_from    = idx;
+        else if (fields[idx] == "to")       col_to      = idx;
+    }
+
+    int last_col = std::max({ col_time, col_user, col_channel, col_hint, col_dist, col_from, col_to });
+    if (std::min({ col_time, col_user, col_channel, col_hint, col_dist, col_from, col_to }) < 0) {
+        return false;
+    }
+
+    //-- The previous move, to credit it with the distance it covered and
+    //-- to time the gap to this one.
+    Stats* prev_stats = nullptr;
+    int    prev_dist  = -1;
+    double prev_time  = 0.0;
+
+    //-- Rows of the same user and channel come in runs; skip the lookup.
+    std::string user, channel;
+    Stats* stats = nullptr;
+    std::vector<Stats*> touched;
+
+    while (csv.next(fields)) {
+
+        if (static_cast<int>(fields.size()) <= last_col) continue;
+        rows++;
+
+        double time = CsvTokenizer::toDouble(fields[col_time], 0.0);
+        int    dist = CsvTokenizer::toInt(fields[col_dist], -1);
+
+        //-- ``dist`` is logged before each move, so this row says how far
+        //-- the previous move got (the final row is the end board).
+        if (prev_stats != nullptr && prev_dist >= 0 && dist >= 0) {
+            prev_stats->progress += prev_dist - dist;
+        }
+
+        int from = CsvTokenizer::toInt(fields[col_from], -1);
+        int to   = CsvTokenizer::toInt(fields[col_to],   -1);
+        if (from < 0 || to < 0) {
+            prev_stats = nullptr;
+            continue;
+        }
+
+        if (stats == nullptr || fields[col_user] != user || fields[col_channel] != channel) {
+            user.assign(fields[col_user]);
+            channel.assign(fields[col_channel]);
+            stats = &table[{ user, channel }];
+            if (std::find(touched.begin(), touched.end(), stats) == touched.end()) {
+                touched.push_back(stats);
+            }
+        }
+
+        stats->moves++;
+
+        //-- The hint is ``<from> <to>``, same as the move would be.
+        std::string_view hint = fields[col_hint];
+        std::size_t space = hint.find(' ');
+        if (space != std::string_view::npos &&
+            CsvTokenizer::toInt(hint.substr(0, space), -2) == from &&
+            CsvTokenizer::toInt(hint.substr(space + 1), -2) == to) {
+            stats->followed++;
+        }
+
+        if (prev_stats != nullptr) {
+            double gap = time - prev_time;
+            stats->gaps++;
+            stats->gap_sum += gap;
+            stats->gap_sq  += gap * gap;
+            stats->gap_max  = std::max(stats->gap_max, gap);
+        }
+
+        prev_stats = stats;
+        prev_dist  = dist;
+        prev_time  = time;
+    }
+
+    //-- Sessions count once per row, and once for the user overall.
+    for (Stats* row : touched) {
+        row->sessions++;
+    }
+    if (!touched.empty()) {
+        table[{ user, "*" }].sessions++;
+    }
+
+    return true;
+}
+
+
+bool SessionAnalytics::writeSummary(const Table& table) {
+
+    //-- Roll up. The parse only fills (user, *) with its session count.
+    Table summary;
+    for (const auto& row : table) {
+
+        const std::string& user    = row.first.first;
+        const std::string& channel = row.first.second;
+
+        if (channel == "*") {
+            summary[{ user, "*" }].sessions += row.second.sessions;
+            summary[{ "*",  "*" }].sessions += row.second.sessions;
+            continue;
+        }
+
+        summary[{ user, channel }].merge(row.second, true);
+        summary[{ "*",  channel }].merge(row.second, true);
+        summary[{ user, "*"     }].merge(row.second, false);
+        summary[{ "*",  "*"     }].merge(row.second, false);
+    }
+
+    FILE* output = std::fopen(_output.c_str(), "w");
+    if (output == nullptr) {
+        yError("%s: Unable to write %s!!", _module_name.c_str(), _output.c_str());
+        return false;
+    }
+
+    std::fprintf(output, "user,channel,sessions,moves,follow_rate,progress,gap_mean,gap_std,gap_max\n");
+    for (const auto& row : summary) {
+
+        const Stats& stats = row.second;
+        double moves     = static_cast<double>(stats.moves);
+        double gap_mean  = (stats.gaps ? stats.gap_sum / stats.gaps : 0.0);
+        double gap_var   = (stats.gaps > 1 ? (stats.gap_sq - stats.gaps * gap_mean * gap_mean) / (stats.gaps - 1) : 0.0);
+
+        std::fprintf(output, "%s,%s,%zu,%zu,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+            row.first.first.c_str(), row.first.second.c_str(), stats.sessions, stats.moves,
+            (stats.moves ? stats.followed / moves : 0.0), (stats.moves ? stats.progress / moves : 0.0),
+            gap_mean, std::sqrt(std::max(0.0, gap_var)), stats.gap_max);
+    }
+
+    std::fclose(output);
+    yInfo("%s: Wrote %zu rows to %s", _module_name.c_str(), summary.size(), _output.c_str());
+
+    return true;
+}
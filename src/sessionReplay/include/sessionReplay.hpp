@@ -0,0 +1,127 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef SESSION_REPLAY_HPP
+#define SESSION_REPLAY_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/RpcClient.h>
+
+#include <csvTokenizer.hpp>
+#include <mappedFile.hpp>
+
+
+/* ================================================================================
+**  Replays the moves of a CsvLogger file against a game server, the way the
+**  interface sent them, and checks the server ends up where the log says.
+** ================================================================================ */
+class SessionReplay {
+
+    private:
+    /* ============================================================================
+    **  A logged row: the board before a move, and the move. The final row
+    **  of a game has from/to of -1 and only the end board.
+    ** ============================================================================ */
+    struct Move {
+        double      int_time;
+        std::string hint;
+        std::string hash;
+        std::string dist;
+        int         from;
+        int         to;
+    };
+
+
+    /* ============================================================================
+    **  Settings for the replay.
+    ** ============================================================================ */
+    std::string _module_name;
+    std::string _remote;
+    std::string _log_file;
+    std::string _reset;     // command that puts the server back at the start.
+    double      _speed;     // times real time, 0 for back to back.
+    double      _timeout;
+    int         _repeat;
+
+    yarp::os::RpcClient _rpc;
+    std::vector<Move>   _moves;
+
+
+    public:
+    /* ============================================================================
+    **  Main Constructor.
+    ** ============================================================================ */
+    SessionReplay();
+
+
+    /* ============================================================================
+    **  Destructor. Closes the client.
+    ** ============================================================================ */
+    ~SessionReplay();
+
+
+    /* ============================================================================
+    **  Read the settings and the log, and connect to the game server.
+    **
+    ** @param rf
+    **
+    ** @return success of reading the log and connecting.
+    ** ============================================================================ */
+    bool configure(yarp::os::ResourceFinder &rf);
+
+
+    /* ============================================================================
+    **  Replay the log ``repeat`` times, then print the report.
+    **
+    ** @return false on the first divergence.
+    ** ============================================================================ */
+    bool run();
+
+
+    private:
+    /* ============================================================================
+    **  Read the moves out of a CsvLogger file.
+    ** ============================================================================ */
+    bool loadLog(const std::string& fname);
+
+
+    /* ============================================================================
+    **  One pass over the moves, timing each one's round of requests.
+    ** ============================================================================ */
+    bool replay(int pass, std::vector<double>& latencies);
+
+
+    /* ============================================================================
+    **  Send a command and get the first word of the reply.
+    ** ============================================================================ */
+    std::string communicate(const std::string msg);
+
+
+    /* ============================================================================
+    **  Get the value at fraction q of sorted latencies.
+    ** ============================================================================ */
+    static double percentile(const std::vector<double>& sorted, double q);
+
+};
+
+#endif /* SESSION_REPLAY_HPP */
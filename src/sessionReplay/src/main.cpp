@@ -0,0 +1,45 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <iostream>
+#include <string>
+
+#include <yarp/os/Network.h>
+#include <yarp/os/LogStream.h>
+
+#include <sessionReplay.hpp>
+
+
+int main (int argc, char **argv) {
+
+    //-- Init the yarp network.
+    yarp::os::Network yarp;
+    if (!yarp.checkNetwork()) {
+        yError() << "Cannot make connection with the YARP server!!";
+        return EXIT_FAILURE;
+    }
+
+    //-- Config the resource finder.
+    yarp::os::ResourceFinder rf;
+    rf.setVerbose(false);
+    rf.setDefaultConfigFile("config.ini");    // overridden by --from parameter
+    rf.setDefaultContext("session_replay");    // overridden by --context parameter
+    rf.configure(argc,argv);
+
+    //-- Run the replay and return its status.
+    SessionReplay session_replay;
+    if (!session_replay.configure(rf)) {
+        return EXIT_FAILURE;
+    }
+
+    return (session_replay.run() ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,221 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <sessionReplay.hpp>
+
+
+SessionReplay::SessionReplay() :
+    _speed(1.0), _timeout(0.0), _repeat(1) {
+}
+
+
+SessionReplay::~SessionReplay() {
+    _rpc.close();
+}
+
+
+bool SessionReplay::configure(yarp::os::ResourceFinder &rf) {
+
+    //-- Get some variables from the configuration file that the resource finder loaded.
+    _module_name = rf.check("name",    yarp::os::Value("/sessionReplay"), "module name (string)").asString();
+    _remote      = rf.check("remote",  yarp::os::Value("/yarpTower/rpc"), "game server port (string)").asString();
+    _log_file    = rf.check("log",     yarp::os::Value(""),    "session log to replay (string)").asString();
+    _reset       = rf.check("reset",   yarp::os::Value(""),    "command to restart the game, if any (string)").asString();
+    _speed       = rf.check("speed",   yarp::os::Value(1.0),   "times real time, 0 for max (double)").asFloat64();
+    _timeout     = rf.check("timeout", yarp::os::Value(5.0),   "reply timeout in seconds (double)").asFloat64();
+    _repeat      = rf.check("repeat",  yarp::os::Value(1),     "number of passes (int)").asInt32();
+
+    if (_repeat > 1 && _reset.empty()) {
+        yError("%s: A reset command is needed to replay more than once!!", _module_name.c_str());
+        return false;
+    }
+
+    if (!loadLog(_log_file)) {
+        yError("%s: Unable to read moves from %s!!", _module_name.c_str(), _log_file.c_str());
+        return false;
+    }
+
+    //-- Connect the way the interface does.
+    std::string rpc_name = _module_name + "/rpc";
+    if (!_rpc.open(rpc_name)) {
+        yError("%s: Unable to open port %s!!", _module_name.c_str(), rpc_name.c_str());
+        return false;
+    }
+    _rpc.setTimeout(static_cast<float>(_timeout));
+
+    if (!yarp::os::Network::connect(rpc_name, _remote)) {
+        yError("%s: Unable to connect %s to %s!!", _module_name.c_str(), rpc_name.c_str(), _remote.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+
+bool SessionReplay::run() {
+
+    if (_speed > 0.0) {
+        yInfo("%s: Replaying %zu rows of %s on %s at %gx", _module_name.c_str(), _moves.size(), _log_file.c_str(), _remote.c_str(), _speed);
+    } else {
+        yInfo("%s: Replaying %zu rows of %s on %s at max speed", _module_name.c_str(), _moves.size(), _log_file.c_str(), _remote.c_str());
+    }
+
+    std::vector<double> latencies;
+    auto start = std::chrono::steady_clock::now();
+
+    bool ok = true;
+    for (int pass = 0; ok && pass < _repeat; ++pass) {
+        if (!_reset.empty()) {
+            communicate(_reset);
+        }
+        ok = replay(pass, latencies);
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //-- Each move is the round of requests the interface makes for it.
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%8s %10s %10s %9s %9s %9s %9s\n", "moves", "seconds", "moves/s", "p50 ms", "p90 ms", "p99 ms", "max ms");
+    std::printf("%8zu %10.3f %10.1f %9.3f %9.3f %9.3f %9.3f\n",
+        latencies.size(), elapsed, (elapsed > 0.0 ? latencies.size() / elapsed : 0.0),
+        percentile(latencies, 0.50) * 1e3, percentile(latencies, 0.90) * 1e3,
+        percentile(latencies, 0.99) * 1e3, (latencies.empty() ? 0.0 : latencies.back() * 1e3));
+
+    if (ok) {
+        yInfo("%s: All %d passes matched the log", _module_name.c_str(), _repeat);
+    }
+
+    return ok;
+}
+
+
+bool SessionReplay::loadLog(const std::string& fname) {
+
+    MappedFile file;
+    if (fname.empty() || !file.open(fname)) {
+        return false;
+    }
+
+    CsvTokenizer csv(file.view());
+    std::vector<std::string_view> fields;
+
+    //-- Find the columns by name, as the analytics do.
+    if (!csv.next(fields)) {
+        return false;
+    }
+
+    int col_time = -1, col_hint = -1, col_hash = -1, col_dist = -1, col_from = -1, col_to = -1;
+    for (int idx = 0; idx < static_cast<int>(fields.size()); ++idx) {
+        if      (fields[idx] == "int_time") col_time = idx;
+        else if (fields[idx] == "hint_id")  col_hint = idx;
+        else if (fields[idx] == "hash")     col_hash = idx;
+        else if (fields[idx] == "dist")     col_dist = idx;
+        else if (fields[idx] == "from")     col_from = idx;
+        else if (fields[idx] == "to")       col_to   = idx;
+    }
+
+    int last_col = std::max({ col_time, col_hint, col_hash, col_dist, col_from, col_to });
+    if (std::min({ col_time, col_hint, col_hash, col_dist, col_from, col_to }) < 0) {
+        return false;
+    }
+
+    while (csv.next(fields)) {
+
+        if (static_cast<int>(fields.size()) <= last_col) continue;
+
+        Move move;
+        move.int_time = CsvTokenizer::toDouble(fields[col_time], 0.0);
+        move.hint.assign(fields[col_hint]);
+        move.hash.assign(fields[col_hash]);
+        move.dist.assign(fields[col_dist]);
+        move.from     = CsvTokenizer::toInt(fields[col_from], -1);
+        move.to       = CsvTokenizer::toInt(fields[col_to],   -1);
+        _moves.push_back(move);
+    }
+
+    return !_moves.empty();
+}
+
+
+bool SessionReplay::replay(int pass, std::vector<double>& latencies) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t idx = 0; idx < _moves.size(); ++idx) {
+
+        const Move& move = _moves[idx];
+
+        //-- Keep the logged spacing, scaled.
+        if (_speed > 0.0) {
+            std::this_thread::sleep_until(start + std::chrono::duration<double>(move.int_time / _speed));
+        }
+
+        auto sent = std::chrono::steady_clock::now();
+
+        //-- Same requests as the interface makes for a move: a tick's show
+        //-- and hint, then hash, dist and the move itself.
+        bool is_move = (move.from >= 0 && move.to >= 0);
+        if (is_move) {
+            communicate("show");
+            std::string hint = communicate("hint");
+            if (hint != move.hint) {
+                //-- Several moves can be equally good, so only note it.
+                yWarning("%s: Pass %d row %zu: log has hint %s, server has %s", 
+                    _module_name.c_str(), pass, idx + 1, move.hint.c_str(), hint.c_str());
+            }
+        }
+
+        //-- The board before the move must be the logged one.
+        std::string hash = communicate("hash");
+        std::string dist = communicate("dist");
+        if (hash != move.hash || dist != move.dist) {
+            yError("%s: Pass %d diverged at row %zu (t=%.3f): log has hash %s dist %s, server has hash %s dist %s!!", 
+                _module_name.c_str(), pass, idx + 1, move.int_time, 
+                move.hash.c_str(), move.dist.c_str(), hash.c_str(), dist.c_str());
+            return false;
+        }
+
+        //-- Final row, the end board matched.
+        if (!is_move) {
+            continue;
+        }
+
+        std::string status = communicate("move " + std::to_string(move.from) + " " + std::to_string(move.to));
+        if (status == "0") {
+            yError("%s: Pass %d diverged at row %zu (t=%.3f): move %d %d was refused!!", 
+                _module_name.c_str(), pass, idx + 1, move.int_time, move.from, move.to);
+            return false;
+        }
+
+        latencies.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - sent).count());
+    }
+
+    return true;
+}
+
+
+std::string SessionReplay::communicate(const std::string msg) {
+
+    yarp::os::Bottle command, response;
+    command.addString(msg);
+
+    _rpc.write(command, response);
+
+    return response.get(0).asString();
+}
+
+
+double SessionReplay::percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    std::size_t idx = static_cast<std::size_t>(q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
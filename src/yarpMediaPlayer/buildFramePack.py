@@ -0,0 +1,129 @@
+#!/usr/bin/python3
+
+## ================================================================================
+## Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+##     University of Waterloo, All rights reserved.
+## 
+## Authors: 
+##     Austin Kothig <austin.kothig@uwaterloo.ca>
+## 
+## CopyPolicy: Released under the terms of the MIT License. 
+##     See the accompanying LICENSE file for details.
+## ================================================================================
+
+import glob
+import json
+import mmap
+import os
+import struct
+
+import numpy as np
+import cv2
+
+import argparse
+
+def getArgs():
+    parser = argparse.ArgumentParser(description='buildFramePack')
+    parser.add_argument('clips',  nargs='+',                          help='Clips, or directories of mp4s, to pack.')
+    parser.add_argument('-o', '--output', default='clips.pack',       help='Pack file to write.           (default: {})'.format('clips.pack'))
+    parser.add_argument('-H',             default=540,   type=int,    help='Height for the window to be.  (default: {})'.format(540))
+    parser.add_argument('-W',             default=960,   type=int,    help='Width for the window to be.   (default: {})'.format(960))
+    args = parser.parse_args()
+    return args
+
+
+## ================================================================================
+##  Pack layout (little endian), read by yarpMediaPlayer.py --pack:
+##
+##    header : magic "FPAK", version, width, height, channels,
+##             index offset, index size                     (PACK_HEADER)
+##    frames : raw BGR frames of width*height*channels bytes, each clip
+##             starting on a page boundary
+##    index  : json of { clip name : [byte offset, frame count, fps] }
+## ================================================================================
+PACK_MAGIC   = b'FPAK'
+PACK_VERSION = 1
+PACK_HEADER  = struct.Struct('<4sIIIIQQ')
+
+
+def findClips(paths):
+
+    clips = []
+    for path in paths:
+        if os.path.isdir(path):
+            clips += sorted(glob.glob(os.path.join(path, '*.mp4')))
+        else:
+            clips.append(path)
+
+    return clips
+
+
+def writeClip(output, file, width, height):
+
+    video = cv2.VideoCapture(file)
+    if not video.isOpened():
+        print("Could not open ``{}``!!".format(file))
+        return None
+
+    # Start each clip on a page so it can be advised on its own.
+    offset = output.tell()
+    pad = -offset % mmap.PAGESIZE
+    output.write(b'\0' * pad)
+    offset += pad
+
+    # Same resize as the player, done once here instead of every playback.
+    count = 0
+    while True:
+        ret, frame = video.read()
+        if not ret:
+            break
+
+        frame = cv2.resize(frame,
+            (width, height),
+            fx=0, fy=0,
+            interpolation=cv2.INTER_CUBIC
+        )
+        output.write(np.ascontiguousarray(frame, dtype=np.uint8).tobytes())
+        count += 1
+
+    fps = video.get(cv2.CAP_PROP_FPS) or 30.
+    video.release()
+
+    return [offset, count, fps]
+
+
+def main():
+
+    # Parse the arguments.
+    args = getArgs()
+
+    clips = findClips(args.clips)
+    index = {}
+
+    with open(args.output, 'wb') as output:
+
+        # Header is filled in once the index is written.
+        output.write(b'\0' * PACK_HEADER.size)
+
+        for file in clips:
+            entry = writeClip(output, file, args.W, args.H)
+            if entry is None: continue
+
+            # Clips are found by name, wherever the player is told they are.
+            index[os.path.basename(file)] = entry
+            print("Packed ``{}``: {} frames at {} fps.".format(file, entry[1], entry[2]))
+
+        index_offset = output.tell()
+        index_bytes  = json.dumps(index).encode()
+        output.write(index_bytes)
+
+        output.seek(0)
+        output.write(PACK_HEADER.pack(PACK_MAGIC, PACK_VERSION, args.W, args.H, 3, index_offset, len(index_bytes)))
+
+    print("Wrote {} clips to ``{}``.".format(len(index), args.output))
+
+    return
+
+
+if __name__ == '__main__':
+    main()
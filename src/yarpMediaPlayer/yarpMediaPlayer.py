@@ -13,7 +13,15 @@
 
 import numpy as np
 import cv2
+import os
+import json
+import mmap
+import struct
 import time
+import queue
+import threading
+
+from collections import OrderedDict
 
 import yarp
 
@@ -28,8 +36,13 @@ def getArgs():
     parser.add_argument('-W',              default=960,   type=int,    help='Width for the window to be.   (default: {})'.format(960))
     parser.add_argument('-d', '--default', default=None,               help='Default video to play.        (default: {})'.format(None))
     parser.add_argument('-g', '--goal',    default=None,               help='Goal image to send.           (default: {})'.format(None))
-    parser.add_argument('-s', '--speed',   default=10.,   type=float,  help='Speed mutl when jobs todo.    (default: {})'.format(10.))
+    parser.add_argument('-l', '--budget',  default=0.5,   type=float,  help='Held-up clips start at end.   (default: {})'.format(0.5))
+    parser.add_argument('-t', '--stale',   default=3.0,   type=float,  help='Held-up clips are dropped.    (default: {})'.format(3.0))
     parser.add_argument('-b', '--breako',  default=False,              help='Allow ESC and Q to break out? (default: {})'.format(False))
+    parser.add_argument('-p', '--prefetch', default=4,    type=int,    help='Clips to keep opened ahead.   (default: {})'.format(4))
+    parser.add_argument('-c', '--cache',   default=1024,  type=int,    help='MB of decoded clips to keep.  (default: {})'.format(1024))
+    parser.add_argument('-q', '--queue',   default=30,    type=int,    help='Frames to decode ahead.       (default: {})'.format(30))
+    parser.add_argument('-k', '--pack',    default=None,               help='Frame pack from buildFramePack.py. (default: {})'.format(None))
     args = parser.parse_args()
     return args
 
@@ -38,6 +51,140 @@ def getArgs():
 yarp.Network.init()
 
 
+def clipKind(file):
+    '''
+    ``in`` for a hint, ``out`` for retracting one, otherwise ``other``
+    (none states, celebrate, ...).
+    '''
+    name = os.path.splitext(os.path.basename(file))[0]
+    if name.endswith("_in"):  return "in"
+    if name.endswith("_out"): return "out"
+    return "other"
+
+
+class framePack(object):
+    '''
+    Clips pre-transcoded by buildFramePack.py at the window size, mapped in
+    whole. Starting a clip is a slice of the map, with no decoder involved.
+    '''
+    # Must match buildFramePack.py.
+    MAGIC   = b'FPAK'
+    VERSION = 1
+    HEADER  = struct.Struct('<4sIIIIQQ')
+
+    def __init__(self, fname, width, height):
+
+        with open(fname, 'rb') as input:
+            self.map = mmap.mmap(input.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version, w, h, c, index_offset, index_size = self.HEADER.unpack_from(self.map, 0)
+        if magic != self.MAGIC or version != self.VERSION:
+            raise ValueError("not a version {} frame pack".format(self.VERSION))
+        if (w, h) != (width, height):
+            raise ValueError("packed at {}x{}, the window is {}x{}".format(w, h, width, height))
+
+        self.shape = (h, w, c)
+        self.frame_bytes = h * w * c
+        self.index = json.loads(self.map[index_offset:index_offset+index_size])
+
+        return
+
+
+    def get(self, file):
+
+        # Clips are packed by name.
+        entry = self.index.get(os.path.basename(file))
+        if entry is None:
+            return None
+
+        offset, count, fps = entry
+        frames = np.frombuffer(self.map, dtype=np.uint8, count=count*self.frame_bytes, offset=offset)
+
+        return fps, frames.reshape((count,) + self.shape)
+
+
+    def advise(self, file):
+
+        # Ask for the clip's pages to be read in ahead of time.
+        entry = self.index.get(os.path.basename(file))
+        if entry is None:
+            return False
+
+        if hasattr(mmap, 'MADV_WILLNEED'):
+            offset, count, _ = entry
+            self.map.madvise(mmap.MADV_WILLNEED, offset, count*self.frame_bytes)
+
+        return True
+
+
+class frameCache(object):
+    '''
+    LRU cache of fully decoded clips, already resized for the window, so
+    replays skip the decoder and the resize. Bounded by total frame bytes.
+    '''
+    def __init__(self, max_bytes):
+
+        self.max_bytes = max_bytes
+        self.nbytes    = 0
+
+        # (path, width, height) -> (fps, [frames]), least recent first.
+        self.clips = OrderedDict()
+        self.lock  = threading.Lock()
+
+        return
+
+
+    def get(self, key):
+
+        with self.lock:
+            if key not in self.clips:
+                return None
+            self.clips.move_to_end(key)
+            return self.clips[key]
+
+
+    def put(self, key, fps, frames):
+
+        # A clip that could never fit is not worth evicting everything for.
+        size = sum(frame.nbytes for frame in frames)
+        if size == 0 or size > self.max_bytes:
+            return
+
+        with self.lock:
+            if key in self.clips:
+                return
+
+            self.clips[key] = (fps, frames)
+            self.nbytes += size
+
+            while self.nbytes > self.max_bytes:
+                _, (_, old) = self.clips.popitem(last=False)
+                self.nbytes -= sum(frame.nbytes for frame in old)
+
+        return
+
+
+class decodedClip(object):
+    '''
+    A clip handed from the decoder to the presenter. Its frames come through
+    a bounded queue, ending with None.
+    '''
+    def __init__(self, file, seq, sent, received, depth):
+
+        self.file     = file
+        self.seq      = seq
+        self.sent     = sent        # on the sender's clock, only reported back.
+        self.received = received    # when it arrived, on ours.
+        self.fps    = 30.
+        self.loaded = None    # when its first frame was ready.
+        self.frames = queue.Queue(maxsize=depth)
+
+        # Set when the presenter drops it, so the decoder can stop.
+        self.cancelled = False
+
+        return
+
+
 class mediaPlayer(object):
     '''
     Receive requests to open videos. Play them through opencv.
@@ -48,18 +195,55 @@ class mediaPlayer(object):
         self.name       = args.name
         self.default    = args.default
         self.goal       = args.goal
-        self.speedup    = args.speed
+        self.budget     = args.budget
+        self.stale      = args.stale
         self.break_outs = args.breako
         self.xpos       = args.x
         self.ypos       = args.y
         self.height     = args.H
         self.width      = args.W
+        self.prefetch_n = args.prefetch
+
+        # Decoded clips, keyed by path and window size.
+        self.cache = frameCache(args.cache * 1024 * 1024)
+
+        # Pre-transcoded clips, used before the cache and the decoder.
+        self.pack = None
+        if args.pack != None:
+            try:
+                self.pack = framePack(args.pack, self.width, self.height)
+                print("Using {} clips from ``{}``.".format(len(self.pack.index), args.pack))
+            except (OSError, ValueError) as e:
+                print("Could not use frame pack ``{}``: {}!!".format(args.pack, e))
         
+        # Clips waiting to be decoded, as (file, seq, sent, received).
         self.file_buffer = []
+        self.buffer_lock = threading.Lock()
+
+        # The next clip, decoding while the current one is on screen, and how
+        # many frames each clip may be decoded ahead by.
+        self.ready       = queue.Queue(maxsize=1)
+        self.queue_depth = args.queue
+
+        # Whether a hint is on screen for an ``_out`` clip to retract.
+        self.hint_shown = False
+
+        # When the last clip finished playing, so that waiting behind it
+        # doesn't count against the next one.
+        self.free_since = time.monotonic()
+
+        # Frames shown late, or dropped to catch back up, since the start.
+        self.late_frames    = 0
+        self.dropped_frames = 0
 
-        # Open the audio and video streams.
-        self.video = cv2.VideoCapture(self.default)
-        self.fps = self.video.get(cv2.CAP_PROP_FPS)
+        # Clips opened ahead of time on ``prefetch``, oldest first.
+        self.prefetched    = OrderedDict()
+        self.prefetch_lock = threading.Lock()
+
+        # Start with the default video.
+        if self.default != None:
+            now = time.monotonic()
+            self.file_buffer.append((self.default, -1, now, now))
 
         if self.goal != None:
             goal_img = cv2.imread(self.goal)
@@ -68,13 +252,21 @@ class mediaPlayer(object):
             #cv2.moveWindow('goal state', self.height//3, self.width)
             cv2.moveWindow('goal state', self.width, self.height//3)
 
-        # Init a flag for completion of current media.
-        self.playing = True
-
         # Open the yarp port.
         self.port = yarp.BufferedPortBottle()
         self.port.open(self.name + ":i")
 
+        # Report (seq sent loaded presented) for each clip that came with a seq.
+        # Only sent is on the sender's clock; the latencies taken from them
+        # are only meaningful with both on the same host.
+        self.status_port = yarp.BufferedPortBottle()
+        self.status_port.open(self.name + "/status:o")
+
+        # Decode on a thread of its own; the window stays on this one.
+        self.running = True
+        self.decoder = threading.Thread(target=self.decodeLoop, daemon=True)
+        self.decoder.start()
+
         return
 
 
@@ -84,96 +276,365 @@ class mediaPlayer(object):
             
             self.checkPort()
 
-            if self.playing:
-                
-                while self.video.isOpened():
-                    
-                    ret, frame = self.video.read()
-
-                    if not ret:
-                        # End of video.
-                        self.playing = False
-                        self.video.release()
-                        break
-                    
-                    # Wait based on the frames-per-second of the video,
-                    # but if we have multiple videos in the queue, speed
-                    # things up so that we're not waiting too for the
-                    # most recent video clips.
-                    wait_for = int((1000 / self.fps) / (self.speedup if len(self.file_buffer) > 1 else 1.))
-                    key = cv2.waitKey(wait_for)
-                    
-                    # Allow breaking out?
-                    if (key == 27 or key == 1048603) and self.break_outs:
-                        print("Broke out?")
-                        self.cleanup()
-                        exit(0)
-                        break
-                    
-                    # Modify the frame.
-                    frame = cv2.resize(frame,
-                        (self.width, self.height),
-                        fx=0, fy=0,
-                        interpolation=cv2.INTER_CUBIC
-                    )
-                    
-                    cv2.imshow(self.name, frame)
-                    cv2.moveWindow(self.name, self.xpos, self.ypos)
-
-                    self.checkPort()
-
-
-            # If there is something in the beffer, load it.
-            elif len(self.file_buffer):
-
-                # Get the file at the front.
-                file = self.file_buffer[0]
-                self.file_buffer.pop(0)
-
-                if file == "none":
-                    file = self.default
-                    if file == None: continue
-
-                # Load the file.
-                print("Loading file: {}".format(file))
-                self.video.open(file)
-
-                if not self.video.isOpened():
-                    print("Could not open ``{}``!!".format(file))
-
-                else:
-                    self.fps = self.video.get(cv2.CAP_PROP_FPS)
-                    self.playing = True
-
-
-            # Else wait for some input.
+            # Play the next clip as soon as the decoder has it.
+            try:
+                clip = self.ready.get(timeout=0.1)
+            except queue.Empty:
+                if not self.pending():
+                    print("Waiting for video . . .")
+                continue
+
+            # Decide what the clip is still worth.
+            action = self.policy(clip)
+            if action == "drop":
+                print("Dropping ``{}``.".format(clip.file))
+                clip.cancelled = True
+                continue
+
+            kind = clipKind(clip.file)
+            if kind != "other":
+                self.hint_shown = (kind == "in")
+
+            if action == "last":
+                self.presentLast(clip)
             else:
-                print("Waiting for video . . .")
-                time.sleep(0.1)
+                self.present(clip)
+            self.free_since = time.monotonic()
 
         return
 
-    
+
+    def policy(self, clip):
+
+        kind = clipKind(clip.file)
+
+        # Retracting a hint that was never shown would only confuse.
+        if kind == "out" and not self.hint_shown:
+            return "drop"
+
+        # A newer hint is waiting, so this one is obsolete.
+        with self.buffer_lock:
+            if kind == "in" and any(clipKind(entry[0]) == "in" for entry in self.file_buffer):
+                return "drop"
+
+        # Otherwise it depends on how long it has been held up, from when it
+        # arrived or the clip ahead of it finished, whichever is later. The
+        # interface sends the next ``_in`` 0.2-0.3 s after an ``_out`` of
+        # 1-3.5 s, and that ``_in`` has to play in full once the ``_out`` ends.
+        # Stale clips are dropped, unless it's the last thing to show.
+        waited = time.monotonic() - max(clip.received, self.free_since)
+        if waited > self.stale and self.pending() > 0:
+            return "drop"
+        if waited > self.budget:
+            return "last"
+
+        return "play"
+
+
+    def present(self, clip):
+
+        # Each frame is due a period after the last one's deadline, not after
+        # the work done since, so decoding and checkPort don't slow us down.
+        deadline = None
+        late, dropped, first = 0, 0, True
+
+        while True:
+
+            try:
+                frame = clip.frames.get(timeout=0.1)
+            except queue.Empty:
+                self.checkPort()
+                continue
+
+            if frame is None:
+                # End of video.
+                break
+
+            # Wait based on the frames-per-second of the video.
+            period = 1. / clip.fps
+
+            now = time.monotonic()
+            if deadline is None:
+                deadline = now
+
+            # A whole frame behind, skip this one to catch up.
+            if now > deadline + period:
+                dropped  += 1
+                deadline += period
+                continue
+
+            # Note: waitKey(0) waits forever, so wait at least a millisecond.
+            shown = self.show(frame, max(1, int((deadline - now) * 1000)))
+            if shown > deadline + period / 2:
+                late += 1
+
+            # Report once its first frame is up.
+            if first:
+                first = False
+                if clip.seq >= 0:
+                    self.reportStatus(clip, shown)
+
+            deadline += period
+
+            self.checkPort()
+
+        self.late_frames    += late
+        self.dropped_frames += dropped
+        print("Played ``{}``: {} late, {} dropped ({} late, {} dropped in total).".format(
+            clip.file, late, dropped, self.late_frames, self.dropped_frames))
+
+        return
+
+
+    def presentLast(self, clip):
+
+        # Too late to play through, so just put up where it ends.
+        last = None
+        while True:
+
+            try:
+                frame = clip.frames.get(timeout=0.1)
+            except queue.Empty:
+                self.checkPort()
+                continue
+
+            if frame is None:
+                break
+            last = frame
+
+        if last is None:
+            return
+
+        shown = self.show(last, 1)
+        if clip.seq >= 0:
+            self.reportStatus(clip, shown)
+
+        print("Skipped to the end of ``{}``.".format(clip.file))
+
+        return
+
+
+    def show(self, frame, wait_for):
+
+        key = cv2.waitKey(wait_for)
+        
+        # Allow breaking out?
+        if (key == 27 or key == 1048603) and self.break_outs:
+            print("Broke out?")
+            self.cleanup()
+            exit(0)
+        
+        cv2.imshow(self.name, frame)
+        cv2.moveWindow(self.name, self.xpos, self.ypos)
+        cv2.waitKey(1) # paint now rather than at the next wait.
+
+        return time.monotonic()
+
+
+    def pending(self):
+        with self.buffer_lock:
+            return len(self.file_buffer) + self.ready.qsize()
+
+
     def checkPort(self):
         
         # See if we have mail.
         b = self.port.read(False)
         if b is None:
             return
+        received = time.monotonic()
 
-        # Get the contents of the bottle.
+        # Get the contents of the bottle, with the seq and send stamp if given.
+        # The send stamp is on the sender's clock, so it's only passed back in
+        # the status; how long a clip has waited is timed from receiving it.
         new_file = b.get(0).toString()
-        if new_file == "none" and new_file in self.file_buffer:
-            # Ensure only one copy of "none" in buffer.
-            return
+        seq  = b.get(1).asInt32()   if b.size() > 2 else -1
+        sent = b.get(2).asFloat64() if b.size() > 2 else received
+        with self.buffer_lock:
+            if new_file == "none" and new_file in [entry[0] for entry in self.file_buffer]:
+                # Ensure only one copy of "none" in buffer.
+                return
 
         # Check if we're told to quit.
         if new_file == "exit":
             self.cleanup()
             exit(0)
 
-        # Add this video to the queue.
-        self.file_buffer.append(new_file)
+        # Open the likely next clips without holding up playback.
+        if new_file == "prefetch":
+            clips = b.get(1).asList()
+            files = [clips.get(idx).toString() for idx in range(clips.size())] if clips else []
+            threading.Thread(target=self.openClips, args=(files,), daemon=True).start()
+            return
+
+        # Add this video to the queue. A new hint replaces any still waiting.
+        with self.buffer_lock:
+            if clipKind(new_file) == "in":
+                self.file_buffer = [entry for entry in self.file_buffer if clipKind(entry[0]) != "in"]
+            self.file_buffer.append((new_file, seq, sent, received))
+
+        return
+
+
+    def resize(self, frame):
+        return cv2.resize(frame,
+            (self.width, self.height),
+            fx=0, fy=0,
+            interpolation=cv2.INTER_CUBIC
+        )
+
+
+    def decodeLoop(self):
+
+        while self.running:
+
+            # Take the next clip off the buffer.
+            with self.buffer_lock:
+                entry = self.file_buffer.pop(0) if len(self.file_buffer) else None
+
+            if entry is None:
+                time.sleep(0.005)
+                continue
+
+            file, seq, sent, received = entry
+            if file == "none":
+                file = self.default
+                if file == None: continue
+
+            # Hand it over before decoding so it can start on its first frame.
+            # This waits while the previous one is still next in line.
+            clip = decodedClip(file, seq, sent, received, self.queue_depth)
+            if not self.putWhileRunning(self.ready, clip):
+                return
+
+            self.decodeClip(clip)
+
+        return
+
+
+    def decodeClip(self, clip):
+
+        # Play it straight from the pack or the cache if we can.
+        cached = self.pack.get(clip.file) if self.pack is not None else None
+        if cached is None:
+            cached = self.cache.get((clip.file, self.width, self.height))
+
+        if cached is not None:
+            clip.fps, frames = cached
+            clip.loaded = time.monotonic()
+            for frame in frames:
+                if not self.putWhileRunning(clip.frames, frame, clip):
+                    return
+            self.putWhileRunning(clip.frames, None, clip)
+            return
+
+        # Otherwise load the file, from the prefetched ones if we can.
+        print("Loading file: {}".format(clip.file))
+        with self.prefetch_lock:
+            video = self.prefetched.pop(clip.file, None)
+
+        if video is None:
+            video = cv2.VideoCapture(clip.file)
+
+        if not video.isOpened():
+            print("Could not open ``{}``!!".format(clip.file))
+            self.putWhileRunning(clip.frames, None, clip)
+            return
+
+        # Decode and resize ahead of the presenter, keeping the frames for next time.
+        clip.fps = video.get(cv2.CAP_PROP_FPS) or 30.
+        frames = []
+        while True:
+
+            ret, frame = video.read()
+            if not ret:
+                break
+
+            frame = self.resize(frame)
+            frames.append(frame)
+
+            if clip.loaded is None:
+                clip.loaded = time.monotonic()
+
+            if not self.putWhileRunning(clip.frames, frame, clip):
+                video.release()
+                return
+
+        video.release()
+        self.putWhileRunning(clip.frames, None, clip)
+        self.cache.put((clip.file, self.width, self.height), clip.fps, frames)
+
+        return
+
+
+    def putWhileRunning(self, q, item, clip=None):
+
+        # Block on a full queue, but not past cleanup or the clip being dropped.
+        while self.running and not (clip and clip.cancelled):
+            try:
+                q.put(item, timeout=0.1)
+                return True
+            except queue.Full:
+                continue
+
+        return False
+
+
+    def openClips(self, files):
+
+        for file in files:
+
+            # Packed already? Then just have its pages read in.
+            if self.pack is not None and self.pack.advise(file):
+                continue
+
+            # Already decoded?
+            if self.cache.get((file, self.width, self.height)) is not None:
+                continue
+
+            with self.prefetch_lock:
+                if file in self.prefetched:
+                    self.prefetched.move_to_end(file)
+                    continue
+
+            # Opening is the slow part, so it's done outside the lock.
+            video = cv2.VideoCapture(file)
+            if not video.isOpened():
+                print("Could not prefetch ``{}``!!".format(file))
+                continue
+
+            # With room in the cache, decode the whole clip now.
+            if self.cache.max_bytes > 0:
+                fps, frames = video.get(cv2.CAP_PROP_FPS), []
+                while True:
+                    ret, frame = video.read()
+                    if not ret: break
+                    frames.append(self.resize(frame))
+                video.release()
+                self.cache.put((file, self.width, self.height), fps, frames)
+                continue
+
+            with self.prefetch_lock:
+                if file in self.prefetched:
+                    # Another prefetch got there first.
+                    video.release()
+                    continue
+                self.prefetched[file] = video
+                while len(self.prefetched) > self.prefetch_n:
+                    self.prefetched.popitem(last=False)[1].release()
+
+        return
+
+
+    def reportStatus(self, clip, presented):
+
+        status = self.status_port.prepare()
+        status.clear()
+        status.addInt32(clip.seq)
+        status.addFloat64(clip.sent)
+        status.addFloat64(clip.loaded)
+        status.addFloat64(presented)
+        self.status_port.write()
 
         return
 
@@ -181,13 +642,21 @@ class mediaPlayer(object):
     def cleanup(self):
 
         print("Closing media streams.")
-        if self.video.isOpened():
-            self.video.release()
-            cv2.destroyAllWindows()
+        self.running = False
+        if self.decoder.is_alive() and self.decoder is not threading.current_thread():
+            self.decoder.join()
+        cv2.destroyAllWindows()
+
+        with self.prefetch_lock:
+            for video in self.prefetched.values():
+                video.release()
+            self.prefetched.clear()
 
         print("Closing yarp ports.")
         self.port.interrupt()
         self.port.close()
+        self.status_port.interrupt()
+        self.status_port.close()
         return
 
 
@@ -0,0 +1,51 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <cmath>
+#include <iostream>
+
+
+/* ================================================================================
+**  Bare-bones checks for the test executables. A failed check is reported and
+**  counted, and the test carries on; main returns checkResult().
+** ================================================================================ */
+inline int check_failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond ") failed" << std::endl; \
+            ++check_failures; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol) \
+    do { \
+        if (std::fabs((a) - (b)) > (tol)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK_NEAR(" #a ", " #b ") failed, " \
+                      << (a) << " vs " << (b) << std::endl; \
+            ++check_failures; \
+        } \
+    } while (0)
+
+
+inline int checkResult() {
+    if (check_failures != 0) {
+        std::cerr << check_failures << " checks failed" << std::endl;
+    }
+    return (check_failures == 0 ? 0 : 1);
+}
+
+#endif /* CHECK_HPP */
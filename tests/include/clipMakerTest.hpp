@@ -0,0 +1,74 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#ifndef CLIP_MAKER_TEST_HPP
+#define CLIP_MAKER_TEST_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <clipMaker.hpp>
+
+
+/* ================================================================================
+**  Gives the tests access to ClipMaker's private behavior paths, on the fake
+**  backend and without any ports.
+** ================================================================================ */
+class ClipMakerTest {
+
+    public:
+    static const int NUM_JOINTS = 16;
+
+
+    /* ============================================================================
+    **  Set up what configure() would for ``backend fake``, minus the rpc port
+    **  and config file. Timelines and event logs go to the working directory.
+    ** ============================================================================ */
+    static bool setup(ClipMaker& cm, double warp) {
+        cm._backend        = "fake";
+        cm._num_joints     = NUM_JOINTS;
+        cm._event_capacity = 4096;
+        cm._events_port    = false;
+        cm._clip_path      = ".";
+        cm._timeline_path  = ".";
+        cm._clock.reset(new VirtualClock(warp));
+        return cm.addInstance("test", "fake", "/fake");
+    }
+
+    static void setConfig(ClipMaker& cm, std::shared_ptr<const ClipConfig> cfg) {
+        std::atomic_store(&cm._config, cfg);
+    }
+
+    static bool home(ClipMaker& cm) {
+        return cm.runHome(*cm._instances[0]);
+    }
+
+    static bool run(ClipMaker& cm, const std::string behavior, int from, int to) {
+        return cm.runBehavior(*cm._instances[0], cm.config(), behavior, from, to);
+    }
+
+    static Robot& robot(ClipMaker& cm) {
+        return *cm._instances[0]->robot;
+    }
+
+    static double now(ClipMaker& cm) {
+        return cm._clock->now();
+    }
+
+    static std::vector<TimelineEntry> timeline(ClipMaker& cm) {
+        return cm._instances[0]->fake_robot->getTimeline();
+    }
+
+};
+
+#endif /* CLIP_MAKER_TEST_HPP */
@@ -0,0 +1,241 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <check.hpp>
+#include <clipMakerTest.hpp>
+
+
+//-- Behaviors run 2x faster than real time; a command may be off by 0.1
+//-- virtual seconds, i.e. 50 ms of scheduling noise on a loaded machine.
+static const double WARP      = 2.0;
+static const double TOLERANCE = 0.1;
+
+
+/* ================================================================================
+**  A command expected on the timeline, at seconds from the behavior's start.
+** ================================================================================ */
+struct Expected {
+    std::string target;
+    std::string command;
+    double      at;
+};
+
+
+/* ================================================================================
+**  The shipped app config, with every pose set apart so moves can be told apart.
+** ================================================================================ */
+static std::shared_ptr<ClipConfig> makeConfig() {
+
+    std::shared_ptr<ClipConfig> cfg(new ClipConfig());
+
+    auto pose = [](double val) { return std::vector<double>(ClipMakerTest::NUM_JOINTS, val); };
+    cfg->left_arm_home      = pose(0.0);
+    cfg->right_arm_home     = pose(1.0);
+    cfg->left_arm_right_peg = pose(10.0);
+    cfg->left_arm_mid_peg   = pose(20.0);
+    cfg->right_arm_mid_peg  = pose(30.0);
+    cfg->right_arm_left_peg = pose(40.0);
+    cfg->body_speed         = 50.0;
+    cfg->body_home_timeout  = 10.0;
+
+    cfg->body_mode        = "position";
+    cfg->body_traj_time   = 1.5;
+    cfg->body_stream_rate = 100.0;
+    cfg->body_hold        = 1.5;
+    cfg->body_stagger     = 0.4;
+    cfg->body_gaze        = false;
+
+    cfg->body_start_tolerance = 5.0;
+
+    cfg->expr_timer = 0.4;
+
+    cfg->gaze_home  = {   0.0,   0.0, 0.5 };
+    cfg->gaze_left  = {  28.0, -10.0, 3.0 };
+    cfg->gaze_mid   = {   0.0, -20.0, 3.0 };
+    cfg->gaze_right = { -28.0, -10.0, 3.0 };
+    cfg->gaze_speed = 0.4;
+
+    cfg->spch_timer   = 3.0;
+    cfg->spch_pattern = { 0.2, 0.2 };
+
+    cfg->build();
+    return cfg;
+}
+
+
+/* ================================================================================
+**  Run a behavior and compare the commands it times against the expected
+**  ones, and its length against the expected total.
+** ================================================================================ */
+static void checkTimeline(ClipMaker& cm, const std::string behavior, int from, int to, 
+                          const std::vector<Expected>& expected, double total) {
+
+    double start = ClipMakerTest::now(cm);
+    CHECK(ClipMakerTest::run(cm, behavior, from, to));
+    CHECK_NEAR(ClipMakerTest::now(cm) - start, total, TOLERANCE);
+
+    //-- Speeds and control modes aren't part of a behavior's choreography.
+    std::vector<TimelineEntry> timeline;
+    for (const TimelineEntry& entry : ClipMakerTest::timeline(cm)) {
+        if (entry.command == "positionMove" || entry.command == "lookAtAbsAngles" || entry.command == "write") {
+            timeline.push_back(entry);
+        }
+    }
+    std::stable_sort(timeline.begin(), timeline.end(), 
+        [](const TimelineEntry& a, const TimelineEntry& b) { return a.stamp < b.stamp; });
+
+    CHECK(timeline.size() == expected.size());
+    for (std::size_t idx = 0; idx < std::min(timeline.size(), expected.size()); ++idx) {
+        CHECK(timeline[idx].target  == expected[idx].target);
+        CHECK(timeline[idx].command == expected[idx].command);
+        CHECK_NEAR(timeline[idx].stamp, expected[idx].at, TOLERANCE);
+    }
+
+    return;
+}
+
+
+/* ================================================================================
+**  body 0 2: right arm out first, the left one a stagger later, then both
+**  back in reverse order after holding for 3 seconds.
+** ================================================================================ */
+static void testBody(ClipMaker& cm) {
+
+    checkTimeline(cm, "body", 0, 2, {
+        { "right_arm", "positionMove", 0.0 },
+        { "left_arm",  "positionMove", 0.4 },
+        { "left_arm",  "positionMove", 3.4 },
+        { "right_arm", "positionMove", 3.8 },
+    }, 6.8);
+
+    //-- The first behavior on a new config sets its speeds, on the timeline too.
+    int speeds = 0;
+    for (const TimelineEntry& entry : ClipMakerTest::timeline(cm)) {
+        if (entry.command == "setRefSpeed" || entry.command == "setTrajTime") ++speeds;
+    }
+    CHECK(speeds == 3);
+}
+
+
+/* ================================================================================
+**  gaze 0 2: home, then three looks from one peg to the other, and home again.
+** ================================================================================ */
+static void testGaze(ClipMaker& cm) {
+
+    std::vector<Expected> expected = { { "gaze", "lookAtAbsAngles", 0.0 } };
+    for (int idx = 0; idx < 3; ++idx) {
+        expected.push_back({ "gaze", "lookAtAbsAngles", 3.0 + 2.4*idx });
+        expected.push_back({ "gaze", "lookAtAbsAngles", 4.2 + 2.4*idx });
+    }
+    expected.push_back({ "gaze", "lookAtAbsAngles", 13.2 });
+
+    checkTimeline(cm, "gaze", 0, 2, expected, 13.2);
+}
+
+
+/* ================================================================================
+**  expr 0 1: one right eyebrow raise, two left ones, then the reactions.
+** ================================================================================ */
+static void testExpression(ClipMaker& cm) {
+
+    const double timer = 0.4;
+
+    std::vector<Expected> expected = { { "face", "write", 0.0 } };
+    double at = 1.0;
+    for (int idx = 0; idx < 1; ++idx, at += 2*timer) {
+        expected.push_back({ "face", "write", at });
+        expected.push_back({ "face", "write", at + timer });
+    }
+    at += 1.0 - timer;
+    for (int idx = 0; idx < 2; ++idx, at += 2*timer) {
+        expected.push_back({ "face", "write", at });
+        expected.push_back({ "face", "write", at + timer });
+    }
+    for (int idx = 0; idx < 5; ++idx) {
+        at += 3.0;
+        expected.push_back({ "face", "write", at });
+    }
+
+    checkTimeline(cm, "expr", 0, 1, expected, at);
+}
+
+
+/* ================================================================================
+**  spch: neutral, then the mouth opens and closes every 0.2 seconds for the
+**  3 seconds of speech.
+** ================================================================================ */
+static void testSpeech(ClipMaker& cm) {
+
+    std::vector<Expected> expected = { { "face", "write", 0.0 } };
+    for (int step = 0; step < 16; ++step) {
+        expected.push_back({ "face", "write", 1.0 + 0.2*step });
+    }
+
+    checkTimeline(cm, "spch", 0, 1, expected, 4.2);
+}
+
+
+/* ================================================================================
+**  minjerk body: streamed from home, but refused before anything moves if an
+**  arm isn't where its trajectory starts.
+** ================================================================================ */
+static void testStartTolerance(ClipMaker& cm) {
+
+    std::shared_ptr<ClipConfig> cfg = makeConfig();
+    cfg->body_mode = "minjerk";
+    cfg->build();
+    ClipMakerTest::setConfig(cm, cfg);
+
+    CHECK(ClipMakerTest::home(cm));
+    CHECK(ClipMakerTest::run(cm, "body", 0, 2));
+
+    //-- Knock the right arm, which goes first, out of place.
+    std::vector<double> off(cfg->right_arm_home);
+    off[0] += 2.0 * cfg->body_start_tolerance;
+    ClipMakerTest::robot(cm).positionMove(Limb::RightArm, off.data());
+
+    CHECK(!ClipMakerTest::run(cm, "body", 0, 2));
+    for (const TimelineEntry& entry : ClipMakerTest::timeline(cm)) {
+        CHECK(entry.command != "setPositions");
+    }
+
+    CHECK(ClipMakerTest::home(cm));
+    CHECK(ClipMakerTest::run(cm, "body", 0, 2));
+
+    ClipMakerTest::setConfig(cm, makeConfig());
+}
+
+
+int main() {
+
+    ClipMaker cm;
+    if (!ClipMakerTest::setup(cm, WARP)) {
+        std::cerr << "Unable to set up the fake backend" << std::endl;
+        return 1;
+    }
+    ClipMakerTest::setConfig(cm, makeConfig());
+
+    testBody(cm);
+    testGaze(cm);
+    testExpression(cm);
+    testSpeech(cm);
+    testStartTolerance(cm);
+
+    cm.close();
+
+    return checkResult();
+}
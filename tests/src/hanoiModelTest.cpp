@@ -0,0 +1,252 @@
+/* ================================================================================
+ * Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+ *     University of Waterloo, All rights reserved.
+ * 
+ * Authors: 
+ *     Austin Kothig <austin.kothig@uwaterloo.ca>
+ * 
+ * CopyPolicy: Released under the terms of the MIT License. 
+ *     See the accompanying LICENSE file for details.
+ * ================================================================================
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <check.hpp>
+#include <hanoiModel.hpp>
+
+
+typedef std::vector<std::vector<int>> Pegs; // disks bottom to top, 0 the smallest.
+
+
+/* ================================================================================
+**  Draw a board the way the server does: a blank header, the peg tops, one
+**  row per disk and the base. Disk n is 2n+3 '=' wide.
+** ================================================================================ */
+static std::string makeBoard(const Pegs& pegs, int num_disks, bool newline=true) {
+
+    const int cell = 2 * num_disks + 3;
+
+    //-- One peg cell, with the given disk or bare (-1).
+    auto peg = [cell](int disk) {
+        std::string row(cell, ' ');
+        if (disk < 0) {
+            row[cell/2] = '|';
+        } else {
+            for (int idx = cell/2 - (disk+1); idx <= cell/2 + (disk+1); ++idx) row[idx] = '=';
+        }
+        return row;
+    };
+
+    std::string board = "\n";
+    for (std::size_t p = 0; p < pegs.size(); ++p) board += peg(-1);
+    board += "\n";
+
+    for (int level = num_disks-1; level >= 0; --level) {
+        for (const auto& disks : pegs) {
+            board += peg(level < static_cast<int>(disks.size()) ? disks[level] : -1);
+        }
+        board += "\n";
+    }
+
+    board += std::string(cell * pegs.size(), '#');
+    if (newline) board += "\n";
+    return board;
+}
+
+
+/* ================================================================================
+**  Every disk stacked on one peg.
+** ================================================================================ */
+static Pegs stacked(int num_pegs, int num_disks, int on) {
+    Pegs pegs(num_pegs);
+    for (int disk = num_disks-1; disk >= 0; --disk) pegs[on].push_back(disk);
+    return pegs;
+}
+
+
+/* ================================================================================
+**  Parse a board the way parseShowable does.
+** ================================================================================ */
+static bool parseBoard(HanoiModel& model, const std::string& board) {
+
+    std::vector<std::string_view> rows;
+    std::string_view view(board);
+    std::size_t start = 0;
+    while (start < view.size()) {
+        std::size_t end = view.find('\n', start);
+        if (end == std::string_view::npos) end = view.size();
+        rows.push_back(view.substr(start, end - start));
+        start = end + 1;
+    }
+
+    return model.parse(rows, !board.empty() && board.back() == '\n');
+}
+
+
+/* ================================================================================
+**  A board read off one position, then decoded to another from its code as
+**  ``code`` answers arrive, has to come out byte for byte as the server draws
+**  the other position.
+** ================================================================================ */
+static void checkRoundTrip(const Pegs& start, const Pegs& other, int num_disks, bool newline=true) {
+
+    std::string board = makeBoard(start, num_disks, newline);
+    std::string expected = makeBoard(other, num_disks, newline);
+
+    HanoiModel model;
+    CHECK(parseBoard(model, board));
+    CHECK(model.numPegs() == static_cast<int>(start.size()));
+    CHECK(model.numDisks() == num_disks);
+
+    std::string rendered;
+    model.render(rendered);
+    CHECK(rendered == board);
+
+    HanoiModel drawn;
+    CHECK(parseBoard(drawn, expected));
+    std::uint64_t code = 0;
+    CHECK(drawn.encode(code));
+
+    CHECK(model.decode(code));
+    CHECK(model.matches(drawn));
+    model.render(rendered);
+    CHECK(rendered == expected);
+
+    return;
+}
+
+
+/* ================================================================================
+**  3 pegs: the start, moves in progress, empty pegs and no trailing '\n'.
+** ================================================================================ */
+static void testThreePegs() {
+
+    checkRoundTrip(stacked(3, 3, 0), stacked(3, 3, 0), 3);
+    checkRoundTrip(stacked(3, 3, 0), { { 2 }, { 1 }, { 0 } }, 3);
+    checkRoundTrip(stacked(3, 3, 0), { { }, { 2, 0 }, { 1 } }, 3);
+    checkRoundTrip({ { 2, 1 }, { }, { 0 } }, stacked(3, 3, 2), 3);
+    checkRoundTrip(stacked(3, 5, 0), { { 4, 3 }, { 2, 1 }, { 0 } }, 5, false);
+
+    //-- Known codes: the smallest disk is the lowest digit.
+    HanoiModel model;
+    std::uint64_t code = 1;
+    CHECK(parseBoard(model, makeBoard(stacked(3, 3, 0), 3)));
+    CHECK(model.encode(code) && code == 0);
+    CHECK(parseBoard(model, makeBoard({ { 2 }, { 1 }, { 0 } }, 3)));
+    CHECK(model.encode(code) && code == 5);
+    CHECK(parseBoard(model, makeBoard(stacked(3, 3, 2), 3)));
+    CHECK(model.encode(code) && code == 26);
+
+    //-- A code with more disks than the board is refused, nothing changed.
+    CHECK(!model.decode(27));
+    CHECK(model.toString() == "() () (2 1 0)");
+
+    return;
+}
+
+
+/* ================================================================================
+**  More pegs, up to the most disks a code holds for them.
+** ================================================================================ */
+static void testMorePegs() {
+
+    checkRoundTrip(stacked(4, 4, 0), { { 3 }, { }, { 2, 1 }, { 0 } }, 4);
+    checkRoundTrip(stacked(9, 6, 4), { { 5 }, { 4 }, { }, { 3 }, { }, { 2 }, { 1 }, { }, { 0 } }, 6);
+
+    CHECK(HanoiModel::maxDisks(3) == 40);
+    CHECK(HanoiModel::maxDisks(4) == 31);
+    CHECK(HanoiModel::maxDisks(9) == 20);
+
+    checkRoundTrip(stacked(4, 31, 0), stacked(4, 31, 3), 31);
+    checkRoundTrip(stacked(9, 20, 0), stacked(9, 20, 8), 20);
+
+    return;
+}
+
+
+/* ================================================================================
+**  40 disks on 3 pegs: codes past INT64_MAX go over the wire as a negative
+**  Int64 and have to come back the same; 41 disks can't be coded at all.
+** ================================================================================ */
+static void testDiskLimit() {
+
+    checkRoundTrip(stacked(3, 40, 0), stacked(3, 40, 2), 40);
+
+    HanoiModel model, drawn;
+    CHECK(parseBoard(model, makeBoard(stacked(3, 40, 0), 40)));
+    CHECK(parseBoard(drawn, makeBoard(stacked(3, 40, 2), 40)));
+
+    std::uint64_t code = 0;
+    CHECK(drawn.encode(code));
+    CHECK(code > static_cast<std::uint64_t>(INT64_MAX));
+
+    std::int64_t wire = static_cast<std::int64_t>(code);
+    CHECK(wire < 0);
+    CHECK(model.decode(static_cast<std::uint64_t>(wire)));
+    CHECK(model.matches(drawn));
+
+    CHECK(parseBoard(model, makeBoard(stacked(3, 41, 0), 41)));
+    CHECK(!model.encode(code));
+    CHECK(!model.decode(0));
+
+    return;
+}
+
+
+/* ================================================================================
+**  The rules behind the local model.
+** ================================================================================ */
+static void testLegalApply() {
+
+    HanoiModel model;
+    CHECK(!model.legal(0, 1));
+    CHECK(!model.apply(0, 1));
+
+    CHECK(parseBoard(model, makeBoard(stacked(3, 3, 0), 3)));
+
+    //-- Nothing to move, the same peg, or no such peg.
+    CHECK(!model.legal(1, 0));
+    CHECK(!model.legal(0, 0));
+    CHECK(!model.legal(-1, 1));
+    CHECK(!model.legal(0, 3));
+
+    CHECK(model.legal(0, 1) && model.legal(0, 2));
+    CHECK(model.apply(0, 2));
+    CHECK(model.toString() == "(2 1) () (0)");
+
+    //-- Never a bigger disk onto a smaller one; nothing moves.
+    CHECK(!model.legal(0, 2));
+    CHECK(!model.apply(0, 2));
+    CHECK(model.toString() == "(2 1) () (0)");
+
+    CHECK(model.apply(0, 1));
+    CHECK(model.apply(2, 1));
+    CHECK(model.toString() == "(2) (1 0) ()");
+
+    //-- Moves drawn from the model come out as the server would draw them.
+    std::string rendered;
+    model.render(rendered);
+    CHECK(rendered == makeBoard({ { 2 }, { 1, 0 }, { } }, 3));
+
+    //-- A bigger disk drawn on a smaller one isn't a position at all.
+    CHECK(!parseBoard(model, makeBoard({ { 0, 1 }, { 2 }, { } }, 3)));
+    CHECK(!model.valid());
+    CHECK(!model.legal(1, 0));
+
+    return;
+}
+
+
+int main() {
+
+    testThreePegs();
+    testMorePegs();
+    testDiskLimit();
+    testLegalApply();
+
+    return checkResult();
+}
@@ -0,0 +1,149 @@
+#!/usr/bin/python3
+
+## ================================================================================
+## Copyright: (C) 2022, SIRRL Social and Intelligent Robotics Research Laboratory, 
+##     University of Waterloo, All rights reserved.
+## 
+## Authors: 
+##     Austin Kothig <austin.kothig@uwaterloo.ca>
+## 
+## CopyPolicy: Released under the terms of the MIT License. 
+##     See the accompanying LICENSE file for details.
+## ================================================================================
+
+'''
+The media player's policy for late clips, stepped through the sequences the
+interface sends on a fake clock. numpy, cv2 and yarp are stubbed out, so
+only the policy runs.
+'''
+
+import os
+import sys
+import types
+import queue
+import threading
+
+sys.dont_write_bytecode = True
+
+for name in ("numpy", "cv2", "yarp"):
+    sys.modules[name] = types.ModuleType(name)
+sys.modules["yarp"].Network = types.SimpleNamespace(init=lambda: None)
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "src", "yarpMediaPlayer"))
+import yarpMediaPlayer
+
+
+class fakeClock(object):
+    '''
+    Stands in for the time module; only moves when told to.
+    '''
+    def __init__(self):
+        self.now = 0.0
+
+    def monotonic(self):
+        return self.now
+
+
+clock = fakeClock()
+yarpMediaPlayer.time = clock
+
+failures = 0
+
+
+def makePlayer():
+
+    # Skip opening the windows, ports and decoder.
+    player = yarpMediaPlayer.mediaPlayer.__new__(yarpMediaPlayer.mediaPlayer)
+    player.budget      = 0.5
+    player.stale       = 3.0
+    player.hint_shown  = False
+    player.file_buffer = []
+    player.buffer_lock = threading.Lock()
+    player.ready       = queue.Queue(maxsize=1)
+    player.free_since  = clock.now
+
+    return player
+
+
+def present(player, file, received, length, expected):
+    '''
+    What run() does with a clip taken off the ready queue now: decide, then
+    keep the presenter busy for the clip's length if it plays.
+    '''
+    global failures
+
+    clip = yarpMediaPlayer.decodedClip(file, 0, received, received, 1)
+    action = player.policy(clip)
+    print("{:6.2f}  {:16} received {:6.2f}  {}".format(clock.now, file, received, action))
+
+    if action != expected:
+        print("    expected {}!!".format(expected))
+        failures += 1
+
+    if action == "drop":
+        return
+
+    kind = yarpMediaPlayer.clipKind(file)
+    if kind != "other":
+        player.hint_shown = (kind == "in")
+
+    if action == "play":
+        clock.now += length
+    player.free_since = clock.now
+
+    return
+
+
+def testMoves():
+    '''
+    The first hint, then a move: the interface sends ``_out`` and the next
+    ``_in`` 0.25 s after it. The ``_in`` waits for the longest ``_out`` in
+    data/vids (3.54 s) and still has to play in full.
+    '''
+    player = makePlayer()
+
+    clock.now = 0.00
+    present(player, "0_2_in.mp4", 0.00, 2.00, "play")
+
+    clock.now = 5.00
+    present(player, "0_2_out.mp4", 5.00, 3.54, "play")
+
+    clock.now += 0.02
+    present(player, "1_2_in.mp4",  5.25, 2.00, "play")
+
+    clock.now = 20.00
+    present(player, "1_2_out.mp4", 20.00, 1.06, "play")
+
+    clock.now += 0.02
+    present(player, "0_1_in.mp4",  20.30, 2.00, "play")
+
+    return
+
+
+def testLate():
+    '''
+    Clips held up with the presenter free: late ones start at the end, stale
+    ones are dropped while something else is waiting.
+    '''
+    player = makePlayer()
+
+    clock.now = 30.00
+    player.free_since = 30.00
+    clock.now = 30.80
+    present(player, "0_2_in.mp4", 30.00, 2.00, "last")
+
+    player.file_buffer.append(("none", -1, 31.0, 31.0))
+    clock.now = 34.50
+    present(player, "0_2_out.mp4", 31.00, 1.06, "drop")
+
+    return
+
+
+if __name__ == '__main__':
+
+    testMoves()
+    testLate()
+
+    if failures:
+        print("{} checks failed".format(failures))
+    sys.exit(1 if failures else 0)